@@ -0,0 +1,64 @@
+// Compares vector<Patient> (as stored by Hospital) with CompactPatientTable:
+// per-record size, a field scan and a name search over the same records.
+// Build and run from the repo root:
+//   g++ -std=c++17 -O2 -Iinclude bench/compact_bench.cpp src/Hospital.cpp src/CSVUtils.cpp src/ChangeFeed.cpp src/CompactRecords.cpp -o compact_bench && ./compact_bench [records]
+#include "CompactRecords.h"
+#include "Hospital.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+template <class F>
+static double timeMs(F f, long &result) {
+    auto t0 = std::chrono::steady_clock::now();
+    result = f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char **argv) {
+    const int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int passes = 20;
+    const char *first[] = {"Alice", "Rahul", "Sneha", "Aarav", "Kavya", "Dev", "Isha", "Manav"};
+    const char *last[] = {"Johnson", "Sharma", "Patil", "Mehta", "Nair", "Malhotra", "Singh", "Kapoor", "Gupta"};
+
+    Hospital hosp;
+    std::mt19937 rng(42); // fixed seed: same data on every run
+    for (int i = 0; i < n; ++i) {
+        std::string name = std::string(first[rng() % 8]) + " " + last[rng() % 9] + " " + std::to_string(rng() % 1000);
+        int age = static_cast<int>(rng() % 90);
+        const char *gender = rng() % 2 ? "M" : "F";
+        hosp.emplacePatient(std::move(name), age, gender, std::to_string(9000000000ULL + rng() % 999999999));
+    }
+    const auto &patients = hosp.getAllPatients();
+    CompactPatientTable compact(patients);
+
+    std::printf("records: %d\n", n);
+    std::printf("bytes/record: Patient %zu (+ heap strings), compact %zu (+ %zu interned strings shared)\n",
+                sizeof(Patient), sizeof(CompactPatientTable::Record), compact.getHeap().size());
+
+    long a = 0, b = 0;
+    double ta = timeMs([&] {
+        long hits = 0;
+        for (int k = 0; k < passes; ++k)
+            for (const auto &p : patients) hits += p.getAge() > 60 && p.getGender() == "F";
+        return hits;
+    }, a);
+    double tb = timeMs([&] {
+        long hits = 0;
+        for (int k = 0; k < passes; ++k)
+            for (const auto &r : compact.getRecords()) hits += r.age > 60 && r.gender == Gender::Female;
+        return hits;
+    }, b);
+    std::printf("age/gender scan x%d: Patient %.1f ms, compact %.1f ms (%.1fx)%s\n",
+                passes, ta, tb, ta / tb, a == b ? "" : "  MISMATCH");
+
+    long c = 0, d = 0;
+    double tc = timeMs([&] { return static_cast<long>(hosp.searchPatientsByName("sharma 12").size()); }, c);
+    double td = timeMs([&] { return static_cast<long>(compact.searchByName("sharma 12").size()); }, d);
+    std::printf("name search: Patient %.1f ms, compact %.1f ms (%.1fx)%s\n",
+                tc, td, tc / td, c == d ? "" : "  MISMATCH");
+
+    return a == b && c == d ? 0 : 1;
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <iostream>
+#include <utility>
 
 class Appointment {
 private:
@@ -13,8 +14,8 @@ private:
 public:
     Appointment() : id(0), patientId(0), doctorId(0), date(), time() {}
 
-    Appointment(int id, int pid, int did, const std::string &date, const std::string &time)
-        : id(id), patientId(pid), doctorId(did), date(date), time(time) {}
+    Appointment(int id, int pid, int did, std::string date, std::string time)
+        : id(id), patientId(pid), doctorId(did), date(std::move(date)), time(std::move(time)) {}
 
     int getId() const noexcept { return id; }
     int getPatientId() const noexcept { return patientId; }
@@ -22,8 +23,8 @@ public:
     const std::string &getDate() const noexcept { return date; }
     const std::string &getTime() const noexcept { return time; }
 
-    void setDate(const std::string &d) { date = d; }
-    void setTime(const std::string &t) { time = t; }
+    void setDate(std::string d) { date = std::move(d); }
+    void setTime(std::string t) { time = std::move(t); }
 
     inline friend std::ostream &operator<<(std::ostream &os, const Appointment &a) {
         os << "Appointment[ID=" << a.id
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <iostream>
+#include <utility>
 
 class Billing {
 private:
@@ -15,13 +16,13 @@ public:
     Billing() : billId(0), appointmentId(0), doctorId(0), amount(0.0), description(), date() {}
 
     Billing(int billId, int appointmentId, int doctorId,
-            double amount, const std::string &description, const std::string &date)
+            double amount, std::string description, std::string date)
         : billId(billId),
           appointmentId(appointmentId),
           doctorId(doctorId),
           amount(amount),
-          description(description),
-          date(date) {}
+          description(std::move(description)),
+          date(std::move(date)) {}
 
     int getBillId() const noexcept { return billId; }
     int getAppointmentId() const noexcept { return appointmentId; }
@@ -1,20 +1,67 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
+#include <initializer_list>
+#include <cstddef>
 
 namespace CSV {
 
-    // Split a string by delimiter. Handles simple quoted fields (e.g. "a, b",c).
+    // Split a string by delimiter. Handles quoted fields (e.g. "a, b",c) and "" escapes;
+    // whitespace outside quotes is trimmed, quoted content is kept verbatim.
     std::vector<std::string> split(const std::string &line, char delimiter);
 
     // Trim whitespace around string
     std::string trim(const std::string &s);
 
-    // Read all rows from a CSV file (skips header)
+    // Read all rows from a CSV file (skips header). Quoted fields may span lines.
     std::vector<std::vector<std::string>> readCSV(const std::string &filename);
 
     // Write CSV (overwrite)
     void writeCSV(const std::string &filename,
                   const std::vector<std::string> &header,
                   const std::vector<std::vector<std::string>> &rows);
+
+    // Buffered CSV writer. Fields are formatted straight into an in-memory buffer
+    // (numbers via std::to_chars) and flushed to "<filename>.tmp". commit() fsyncs
+    // the temp file and renames it over the target, so an interrupted save never
+    // leaves a truncated file behind. Destroying an uncommitted writer discards it.
+    class Writer {
+    private:
+        std::string path;
+        std::string tmpPath;
+        int fd = -1;
+        std::vector<char> buf;
+        std::size_t used = 0;
+        bool rowStart = true;
+
+        void put(const char *data, std::size_t n);
+        void separator();
+        void flush();
+        void closeFile();
+
+    public:
+        explicit Writer(const std::string &filename, std::size_t bufferSize = 1 << 16);
+        ~Writer();
+
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        Writer &field(std::string_view s);
+        Writer &field(long long v);
+        Writer &field(int v) { return field(static_cast<long long>(v)); }
+
+        // Terminate the current row
+        void endRow();
+
+        // Append bytes verbatim (no quoting or separators), for non-CSV output
+        // that wants the same buffered, atomic-replace file handling
+        void raw(std::string_view bytes) { put(bytes.data(), bytes.size()); }
+
+        // Write a whole row (e.g. the header) in one call
+        void row(std::initializer_list<std::string_view> fields);
+
+        // Flush, fsync and atomically replace the target file
+        void commit();
+    };
 }
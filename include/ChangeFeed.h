@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+// Hospital tables, as used by change tracking, the export and the change feed
+enum class Table { Patients, Doctors, Appointments, Billing };
+
+enum class Mutation : std::uint8_t { Add, Edit, Delete, Book, Bill, Reload };
+
+struct MutationEvent {
+    std::uint64_t sequence = 0;  // position in the feed, from 0
+    std::uint64_t version = 0;   // Hospital version stamped by the change
+    Table table = Table::Patients;
+    Mutation kind = Mutation::Add;
+    int id = 0;                  // row ID (0 for Reload)
+};
+
+// Lock-free single-producer / multi-consumer broadcast ring of mutation events.
+// The producer never waits: when a subscriber falls more than `capacity`
+// events behind, the oldest events are overwritten and the subscriber's cursor
+// skips ahead, counting them as dropped. Each slot is a seqlock, so readers
+// detect a slot being overwritten under them and retry.
+//
+// A feed has exactly one producer, so copies never share a ring: copying a
+// feed yields a new empty ring of the same capacity, and existing cursors keep
+// following the original. Moving hands the ring over, so existing cursors
+// follow the moved-to feed; the moved-from feed is detached (publish is a
+// no-op and its cursors never deliver) until something is assigned to it.
+class ChangeFeed {
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};      // 2n+1 while writing event n, 2n+2 once published
+        std::atomic<std::uint64_t> version{0};
+        std::atomic<std::uint64_t> payload{0};  // id | table << 32 | kind << 40
+    };
+    struct Ring {
+        explicit Ring(std::size_t capacity) : slots(new Slot[capacity]), mask(capacity - 1) {}
+        std::unique_ptr<Slot[]> slots;
+        std::uint64_t mask;
+        alignas(64) std::atomic<std::uint64_t> head{0}; // number of events published
+    };
+    std::shared_ptr<Ring> ring; // shared with cursors so they may outlive the feed
+
+public:
+    // One subscriber's read position. A cursor must be used by one thread at a time.
+    class Cursor {
+    private:
+        std::shared_ptr<const Ring> ring;
+        std::uint64_t next;
+        std::uint64_t delivered = 0;
+        std::uint64_t dropped = 0;
+        std::uint64_t maxLag = 0;
+
+    public:
+        struct Stats {
+            std::uint64_t delivered;  // events returned by poll()
+            std::uint64_t dropped;    // events overwritten before this cursor read them
+            std::uint64_t lag;        // events published but not yet read
+            std::uint64_t maxLag;     // highest lag seen by poll()
+        };
+
+        Cursor(std::shared_ptr<const Ring> ring, std::uint64_t next) : ring(std::move(ring)), next(next) {}
+
+        // Next event, or nullopt if the cursor has caught up
+        std::optional<MutationEvent> poll();
+
+        // Hand every available event to `f`; returns how many were delivered
+        template <class F>
+        std::size_t drain(F f) {
+            std::size_t n = 0;
+            while (auto ev = poll()) { f(*ev); ++n; }
+            return n;
+        }
+
+        Stats stats() const noexcept;
+    };
+
+    // Capacity is rounded up to a power of two
+    explicit ChangeFeed(std::size_t capacity = 4096);
+    ChangeFeed(const ChangeFeed &o);
+    ChangeFeed &operator=(const ChangeFeed &o);
+    ChangeFeed(ChangeFeed &&o) noexcept = default;
+    ChangeFeed &operator=(ChangeFeed &&o) noexcept = default;
+
+    // Producer side: wait-free, must only be called from one thread at a time
+    void publish(Table t, Mutation kind, int id, std::uint64_t version) noexcept;
+
+    // New cursor positioned after the latest event
+    Cursor subscribe() const;
+
+    std::uint64_t published() const noexcept { return ring ? ring->head.load(std::memory_order_acquire) : 0; }
+    std::size_t capacity() const noexcept { return ring ? static_cast<std::size_t>(ring->mask + 1) : 0; }
+};
@@ -0,0 +1,173 @@
+#pragma once
+#include "Patient.h"
+#include "Doctor.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Compact storage for patients and doctors. Records are small fixed-size
+// structs (24 bytes) so linear scans touch far less memory than vectors of
+// Patient/Doctor: age is a byte, gender an enum, contact numbers of up to 15
+// digits are packed into an integer and all strings are interned in a heap
+// shared by the table's records. Views expose the same getters as Patient
+// and Doctor, and every field round-trips exactly.
+//
+// Hospital keeps its own vectors as the source of truth; these tables are
+// read-only snapshots for scan-heavy callers (reports, analytics, search):
+//
+//     CompactPatientTable snap(hosp.getAllPatients());
+//     auto gen = hosp.getGeneration(Table::Patients);
+//     ... scan snap.getRecords() / snap.searchByName(q) ...
+//     // rebuild once hosp.getGeneration(Table::Patients) != gen
+//
+// bench/compact_bench.cpp compares record size and scan throughput.
+
+// Interned strings. References returned by get() stay valid for the heap's
+// lifetime. The index holds views into `strings`, so copies rebuild it.
+class StringHeap {
+private:
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, std::uint32_t> index;
+
+    void rebuildIndex();
+
+public:
+    StringHeap() = default;
+    StringHeap(const StringHeap &o) : strings(o.strings) { rebuildIndex(); }
+    StringHeap(StringHeap &&) noexcept = default;
+    StringHeap &operator=(const StringHeap &o);
+    StringHeap &operator=(StringHeap &&) = default;
+
+    std::uint32_t intern(std::string_view s);
+    const std::string &get(std::uint32_t id) const { return strings[id]; }
+    std::size_t size() const noexcept { return strings.size(); }
+};
+
+enum class Gender : std::uint8_t { Unknown, Male, Female, Other };
+
+namespace Compact {
+
+    // "M"/"Male" and "F"/"Female" (any case), "" -> Unknown, anything else -> Other
+    Gender parseGender(std::string_view s);
+
+    // Canonical text: "M", "F", "O" or "". Other spellings (e.g. "Male" or
+    // free text) are kept in the string heap next to the enum.
+    const std::string &genderText(Gender g);
+
+    // Digit-only contacts of up to 15 digits are packed in place (leading zeros
+    // kept); anything else is interned in `heap` and referenced by index.
+    std::uint64_t packContact(std::string_view s, StringHeap &heap);
+    std::string unpackContact(std::uint64_t packed, const StringHeap &heap);
+}
+
+class CompactPatientTable {
+public:
+    struct Record {
+        std::uint64_t contact;
+        std::int32_t id;
+        std::uint32_t name;
+        std::uint32_t genderSpelling;  // heap index, or kCanonical if genderText(gender) is exact
+        std::uint8_t age;
+        Gender gender;
+    };
+    static constexpr std::uint32_t kCanonical = 0xffffffffu;
+
+    class View {
+    private:
+        const CompactPatientTable *table;
+        const Record *rec;
+
+    public:
+        View(const CompactPatientTable *table, const Record *rec) : table(table), rec(rec) {}
+
+        int getId() const noexcept { return rec->id; }
+        const std::string &getName() const { return table->heap.get(rec->name); }
+        int getAge() const noexcept { return rec->age; }
+        const std::string &getGender() const {
+            return rec->genderSpelling == kCanonical ? Compact::genderText(rec->gender)
+                                                     : table->heap.get(rec->genderSpelling);
+        }
+        std::string getContact() const { return Compact::unpackContact(rec->contact, table->heap); }
+        Gender getGenderCode() const noexcept { return rec->gender; }
+
+        Patient toPatient() const { return Patient(getId(), getName(), getAge(), getGender(), getContact()); }
+
+        inline friend std::ostream &operator<<(std::ostream &os, const View &v) { return os << v.toPatient(); }
+    };
+
+private:
+    std::vector<Record> records;
+    StringHeap heap;
+
+public:
+    CompactPatientTable() = default;
+    explicit CompactPatientTable(const std::vector<Patient> &patients);
+
+    void reserve(std::size_t n) { records.reserve(n); }
+
+    // Throws std::invalid_argument if age is outside 0..255
+    void add(const Patient &p);
+    void add(int id, std::string_view name, int age, std::string_view gender, std::string_view contact);
+
+    std::size_t size() const noexcept { return records.size(); }
+    View operator[](std::size_t i) const { return View(this, &records[i]); }
+    const std::vector<Record> &getRecords() const noexcept { return records; }
+    const StringHeap &getHeap() const noexcept { return heap; }
+
+    // Case-insensitive substring match, like Hospital::searchPatientsByName
+    std::vector<View> searchByName(const std::string &q) const;
+};
+
+class CompactDoctorTable {
+public:
+    struct Record {
+        std::uint64_t contact;
+        std::int32_t id;
+        std::uint32_t name;
+        std::uint32_t specialty;
+    };
+
+    class View {
+    private:
+        const CompactDoctorTable *table;
+        const Record *rec;
+
+    public:
+        View(const CompactDoctorTable *table, const Record *rec) : table(table), rec(rec) {}
+
+        int getId() const noexcept { return rec->id; }
+        const std::string &getName() const { return table->heap.get(rec->name); }
+        const std::string &getSpecialty() const { return table->heap.get(rec->specialty); }
+        std::string getContact() const { return Compact::unpackContact(rec->contact, table->heap); }
+
+        Doctor toDoctor() const { return Doctor(getId(), getName(), getSpecialty(), getContact()); }
+
+        inline friend std::ostream &operator<<(std::ostream &os, const View &v) { return os << v.toDoctor(); }
+    };
+
+private:
+    std::vector<Record> records;
+    StringHeap heap;
+
+public:
+    CompactDoctorTable() = default;
+    explicit CompactDoctorTable(const std::vector<Doctor> &doctors);
+
+    void reserve(std::size_t n) { records.reserve(n); }
+
+    void add(const Doctor &d);
+    void add(int id, std::string_view name, std::string_view specialty, std::string_view contact);
+
+    std::size_t size() const noexcept { return records.size(); }
+    View operator[](std::size_t i) const { return View(this, &records[i]); }
+    const std::vector<Record> &getRecords() const noexcept { return records; }
+    const StringHeap &getHeap() const noexcept { return heap; }
+
+    // Case-insensitive substring match, like Hospital::searchDoctorsByName
+    std::vector<View> searchByName(const std::string &q) const;
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace DateTime {
+
+    // Parse "YYYY-MM-DD" into days since 1970-01-01. Returns false if malformed.
+    bool parseDate(std::string_view s, int &days);
+
+    // Format days since 1970-01-01 as "YYYY-MM-DD"
+    std::string formatDate(int days);
+
+    // Parse "HH:MM" into minutes after midnight. Returns false if malformed.
+    bool parseTime(std::string_view s, int &minutes);
+
+    // Format minutes after midnight as "HH:MM"
+    std::string formatTime(int minutes);
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <iostream>
+#include <utility>
 
 class Doctor {
 private:
@@ -12,17 +13,17 @@ private:
 public:
     Doctor() : id(0), name(), specialty(), contact() {}
 
-    Doctor(int id, const std::string &name, const std::string &specialty, const std::string &contact)
-        : id(id), name(name), specialty(specialty), contact(contact) {}
+    Doctor(int id, std::string name, std::string specialty, std::string contact)
+        : id(id), name(std::move(name)), specialty(std::move(specialty)), contact(std::move(contact)) {}
 
     int getId() const noexcept { return id; }
     const std::string &getName() const noexcept { return name; }
     const std::string &getSpecialty() const noexcept { return specialty; }
     const std::string &getContact() const noexcept { return contact; }
 
-    void setName(const std::string &n) { name = n; }
-    void setSpecialty(const std::string &s) { specialty = s; }
-    void setContact(const std::string &c) { contact = c; }
+    void setName(std::string n) { name = std::move(n); }
+    void setSpecialty(std::string s) { specialty = std::move(s); }
+    void setContact(std::string c) { contact = std::move(c); }
 
     inline friend std::ostream &operator<<(std::ostream &os, const Doctor &d) {
         os << "Doctor[ID=" << d.id
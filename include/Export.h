@@ -0,0 +1,54 @@
+#pragma once
+#include "Hospital.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <array>
+#include <vector>
+
+namespace Export {
+
+    enum class Format {
+        Columnar,   // compact binary (layout documented in Export.cpp)
+        Json        // same columns as JSON, for the browser frontend
+    };
+
+    // Rows are encoded and emitted in blocks of at most this many rows
+    constexpr std::size_t kBlockRows = 4096;
+
+    // Where a consumer is up to. Versions are only meaningful within the
+    // Hospital epoch they came from; a default Position asks for everything.
+    struct Position {
+        std::uint64_t epoch = 0;
+        std::uint64_t version = 0;
+    };
+
+    // Stream every row changed after `since`, plus the IDs deleted since then.
+    // Tables reloaded after `since` are sent in full and flagged as reset. If
+    // `since` is from another epoch (another process or a copy), is version 0,
+    // or is ahead of the Hospital, every table is sent in full as a reset.
+    // Returns the position to pass as `since` next time.
+    Position write(const Hospital &h, std::ostream &out, Format fmt, Position since = {});
+
+    // Same as write(), into `file` via a temp file that is fsynced and renamed
+    // into place, so readers never see a partial export. Throws std::runtime_error.
+    Position writeFile(const Hospital &h, const std::string &file, Format fmt, Position since = {});
+
+    // One table of a decoded Columnar export, values rendered back to their CSV text
+    struct TableDelta {
+        bool reset = false;                       // replace the table instead of merging
+        std::vector<std::string> columns;
+        std::vector<std::vector<std::string>> rows;
+        std::vector<int> deleted;
+    };
+
+    struct Delta {
+        Position position;                        // pass as `since` next time
+        std::uint64_t since = 0;                  // version the delta starts from (0 = full)
+        std::array<TableDelta, 4> tables;         // indexed by Table
+    };
+
+    // Decode a Format::Columnar stream. Throws std::runtime_error if it is malformed.
+    Delta read(std::istream &in);
+}
@@ -3,9 +3,17 @@
 #include "Doctor.h"
 #include "Appointment.h"
 #include "Billing.h"
+#include "ResultCache.h"
+#include "ChangeFeed.h"
 #include <vector>
 #include <optional>
 #include <string>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstddef>
+#include <functional>
 
 class Hospital {
 private:
@@ -19,28 +27,134 @@ private:
     int nextAppointmentId = 1;
     int nextBillId = 1;
 
+    // Lookup indexes: ID -> position in the vector, plus the set of booked
+    // (doctor, date, time) slots used for clash detection. Rebuilt after
+    // deletes and loads, updated in place on insert.
+    struct SlotKey {
+        int doctorId;
+        std::string date;
+        std::string time;
+        bool operator==(const SlotKey &o) const {
+            return doctorId == o.doctorId && date == o.date && time == o.time;
+        }
+    };
+    struct SlotKeyHash {
+        std::size_t operator()(const SlotKey &k) const {
+            std::size_t h = std::hash<std::string>()(k.date);
+            h ^= std::hash<std::string>()(k.time) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<int>()(k.doctorId) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+    std::unordered_map<int, std::size_t> patientIndex;
+    std::unordered_map<int, std::size_t> doctorIndex;
+    std::unordered_map<int, std::size_t> appointmentIndex;
+    std::unordered_set<SlotKey, SlotKeyHash> bookedSlots;
+
+    void reindexPatients();
+    void reindexDoctors();
+    void reindexAppointments();
+
+    // Change tracking: every mutation stamps the row with a new global version
+    // and deletes leave a tombstone. Rows loaded from CSV carry the table's
+    // resetVersion implicitly, so bulk loads do not fill the maps.
+    struct TableChanges {
+        std::unordered_map<int, std::uint64_t> rows;
+        std::unordered_map<int, std::uint64_t> deleted;
+        std::uint64_t resetVersion = 0;
+    };
+    std::uint64_t version = 0;
+
+    // Versions restart at 0 in every process and diverge between copies, so
+    // they are only comparable within one epoch: a random ID drawn per
+    // Hospital instance and per copy (moves keep it).
+    static std::uint64_t newEpoch();
+    struct Epoch {
+        std::uint64_t value = newEpoch();
+        Epoch() = default;
+        Epoch(const Epoch &) {}
+        Epoch(Epoch &&) noexcept = default;
+        Epoch &operator=(const Epoch &) { value = newEpoch(); return *this; }
+        Epoch &operator=(Epoch &&) noexcept = default;
+    };
+    Epoch epoch;
+    std::array<TableChanges, 4> changes;
+    std::array<std::uint64_t, 4> generations{}; // version of the last change to each table
+
+    // Query results, validated against the generation of the table they read.
+    // Search caches are bounded by total cached rows. The caches lock
+    // internally, so concurrent const calls are safe; concurrent mutation of
+    // the Hospital itself is not. Copies of a Hospital start with cold caches.
+    static constexpr std::size_t kSearchCacheRows = 100000;
+    static constexpr std::size_t kTotalsCacheEntries = 1024;
+    mutable ResultCache<std::vector<Patient>> patientSearches{kSearchCacheRows};
+    mutable ResultCache<std::vector<Doctor>> doctorSearches{kSearchCacheRows};
+    mutable ResultCache<double> billingTotals{kTotalsCacheEntries};
+
+    // Every mutation is also published to the change feed. A copied Hospital
+    // gets its own empty feed: subscribers of the original never see the
+    // copy's mutations, and the copy's events are numbered from 0. A moved
+    // Hospital takes its feed along, so existing subscribers keep receiving.
+    ChangeFeed feed;
+
+    void touch(Table t, int id, Mutation kind);
+    void drop(Table t, int id);
+    void resetTable(Table t);
+
 public:
+    // Mutations take strings by value: pass temporaries or std::move() them in
+    // and they are moved all the way into the stored entity without copying.
+    // The emplace* variants construct in place and return only the new ID; the
+    // only other allocations per insert are change-tracking and index entries
+    // (checked by tests/alloc_count.cpp).
+
     // Patients
-    Patient addPatient(const std::string &name, int age, const std::string &gender, const std::string &contact);
-    bool editPatient(int id, const std::string &name, int age, const std::string &gender, const std::string &contact);
+    Patient addPatient(std::string name, int age, std::string gender, std::string contact);
+    int emplacePatient(std::string name, int age, std::string gender, std::string contact);
+    bool editPatient(int id, std::string name, int age, std::string gender, std::string contact);
     bool deletePatient(int id);
     std::optional<Patient> findPatientById(int id) const;
-    std::vector<Patient> searchPatientsByName(const std::string &q) const;
+    const Patient *findPatientPtr(int id) const; // no copy; invalidated by later mutations
+    std::vector<Patient> searchPatientsByName(const std::string &q) const; // cached, see patientSearches
+    const std::vector<Patient> &getAllPatients() const;
 
     // Doctors
-    Doctor addDoctor(const std::string &name, const std::string &spec, const std::string &contact);
-    bool editDoctor(int id, const std::string &name, const std::string &spec, const std::string &contact);
+    Doctor addDoctor(std::string name, std::string spec, std::string contact);
+    int emplaceDoctor(std::string name, std::string spec, std::string contact);
+    bool editDoctor(int id, std::string name, std::string spec, std::string contact);
     bool deleteDoctor(int id);
     std::optional<Doctor> findDoctorById(int id) const;
-    std::vector<Doctor> searchDoctorsByName(const std::string &q) const;
+    const Doctor *findDoctorPtr(int id) const; // no copy; invalidated by later mutations
+    std::vector<Doctor> searchDoctorsByName(const std::string &q) const;   // cached, see patientSearches
+    const std::vector<Doctor> &getAllDoctors() const;
 
     // Appointments
-    Appointment bookAppointment(int patientId, int doctorId, const std::string &date, const std::string &time);
+    Appointment bookAppointment(int patientId, int doctorId, std::string date, std::string time);
+    int emplaceAppointment(int patientId, int doctorId, std::string date, std::string time);
     const std::vector<Appointment> &getAllAppointments() const; // return by const-ref to avoid copies
+    const Appointment *findAppointmentPtr(int id) const;
+    bool isSlotBooked(int doctorId, const std::string &date, const std::string &time) const;
 
     // Billing
     Billing generateBill(int appointmentId);
+    int emplaceBill(int appointmentId);
     const std::vector<Billing> &getAllBills() const; // return by const-ref to avoid copies
+    double getTotalBilled() const;
+    double getTotalBilledForDoctor(int doctorId) const;
+
+    // Change versions
+    std::uint64_t getVersion() const noexcept { return version; }
+    std::uint64_t getEpoch() const noexcept { return epoch.value; }   // versions are only comparable within one epoch
+    std::uint64_t getRowVersion(Table t, int id) const;          // version of the last change to row `id`
+    std::uint64_t getResetVersion(Table t) const noexcept;       // version of the last bulk load of `t`
+    std::vector<int> getDeletedSince(Table t, std::uint64_t since) const;
+    std::uint64_t getGeneration(Table t) const noexcept;          // bumped by every change to `t`
+
+    // Change feed: typed events for every add, edit, delete, book, bill and reload.
+    // Cursors belong to this Hospital's feed (copies publish to their own; moves
+    // carry it over).
+    ChangeFeed::Cursor subscribe() const { return feed.subscribe(); }
+    const ChangeFeed &getChangeFeed() const noexcept { return feed; }
 
     // CSV
     void loadPatients(const std::string &file);
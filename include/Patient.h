@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <iostream>
+#include <utility>
 
 class Patient {
 private:
@@ -13,8 +14,8 @@ private:
 public:
     Patient() : id(0), name(), age(0), gender(), contact() {}
 
-    Patient(int id, const std::string &name, int age, const std::string &gender, const std::string &contact)
-        : id(id), name(name), age(age), gender(gender), contact(contact) {}
+    Patient(int id, std::string name, int age, std::string gender, std::string contact)
+        : id(id), name(std::move(name)), age(age), gender(std::move(gender)), contact(std::move(contact)) {}
 
     int getId() const noexcept { return id; }
     const std::string &getName() const noexcept { return name; }
@@ -22,10 +23,10 @@ public:
     const std::string &getGender() const noexcept { return gender; }
     const std::string &getContact() const noexcept { return contact; }
 
-    void setName(const std::string &n) { name = n; }
+    void setName(std::string n) { name = std::move(n); }
     void setAge(int a) { age = a; }
-    void setGender(const std::string &g) { gender = g; }
-    void setContact(const std::string &c) { contact = c; }
+    void setGender(std::string g) { gender = std::move(g); }
+    void setContact(std::string c) { contact = std::move(c); }
 
     inline friend std::ostream &operator<<(std::ostream &os, const Patient &p) {
         os << "Patient[ID=" << p.id
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Bounded LRU cache of query results. Each entry is stamped with the
+// generation of the data it was computed from; a lookup with a newer
+// generation treats the entry as stale and evicts it, so results computed
+// before a mutation are never returned.
+//
+// The bound is a total cost (e.g. cached rows) rather than an entry count,
+// so a few queries matching most of a large table cannot pin copies of it;
+// a single result costing more than the budget is not cached at all.
+// All operations lock an internal mutex and values are shared immutable
+// snapshots, so concurrent readers may use one cache. Copying a cache
+// yields an empty cache with the same budget; moving one (which must not race
+// with other use of the source) takes its entries and leaves it empty.
+template <class Value>
+class ResultCache {
+private:
+    struct Entry {
+        std::string key;
+        std::uint64_t generation;
+        std::size_t cost;
+        std::shared_ptr<const Value> value;
+    };
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<std::string, typename std::list<Entry>::iterator> index;
+    std::size_t budget;
+    std::size_t used = 0;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    mutable std::mutex mtx;
+
+    void erase(typename std::unordered_map<std::string, typename std::list<Entry>::iterator>::iterator it) {
+        used -= it->second->cost;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+public:
+    explicit ResultCache(std::size_t budget) : budget(budget) {}
+    ResultCache(const ResultCache &o) : budget(o.getBudget()) {}
+    ResultCache(ResultCache &&o) noexcept
+        : entries(std::move(o.entries)), index(std::move(o.index)), budget(o.budget), used(o.used),
+          hits(o.hits), misses(o.misses) {
+        o.entries.clear();
+        o.index.clear();
+        o.used = 0;
+    }
+    ResultCache &operator=(const ResultCache &o) {
+        if (this != &o) {
+            std::size_t b = o.getBudget();
+            std::lock_guard<std::mutex> lock(mtx);
+            entries.clear();
+            index.clear();
+            used = 0;
+            budget = b;
+        }
+        return *this;
+    }
+
+    // Cached value for `key` if it was computed at `generation`, else nullptr
+    std::shared_ptr<const Value> get(const std::string &key, std::uint64_t generation) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = index.find(key);
+        if (it == index.end()) { ++misses; return nullptr; }
+        if (it->second->generation != generation) {
+            erase(it);
+            ++misses;
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        ++hits;
+        return it->second->value;
+    }
+
+    // Store `value` (if it fits the budget) and return it as a shared snapshot
+    std::shared_ptr<const Value> put(const std::string &key, std::uint64_t generation, Value value, std::size_t cost) {
+        auto shared = std::make_shared<const Value>(std::move(value));
+        if (cost > budget) return shared;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = index.find(key);
+        if (it != index.end()) erase(it);
+        entries.push_front(Entry{key, generation, cost, shared});
+        index.emplace(key, entries.begin());
+        used += cost;
+        while (used > budget) erase(index.find(entries.back().key));
+        return shared;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mtx);
+        entries.clear();
+        index.clear();
+        used = 0;
+    }
+
+    std::size_t size() const { std::lock_guard<std::mutex> lock(mtx); return entries.size(); }
+    std::size_t getUsed() const { std::lock_guard<std::mutex> lock(mtx); return used; }
+    std::size_t getBudget() const { std::lock_guard<std::mutex> lock(mtx); return budget; }
+    std::size_t getHits() const { std::lock_guard<std::mutex> lock(mtx); return hits; }
+    std::size_t getMisses() const { std::lock_guard<std::mutex> lock(mtx); return misses; }
+};
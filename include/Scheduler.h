@@ -0,0 +1,54 @@
+#pragma once
+#include "Hospital.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// One appointment request in a batch: the scheduler picks the doctor and slot
+struct ScheduleRequest {
+    int patientId = 0;
+    std::string specialty;
+    std::string earliestDate;            // YYYY-MM-DD, inclusive
+    std::string latestDate;              // YYYY-MM-DD, inclusive
+    std::optional<int> preferredDoctorId;
+};
+
+struct ScheduleResult {
+    std::size_t request = 0;             // index into the request batch
+    bool assigned = false;
+    int appointmentId = 0;
+    int doctorId = 0;
+    std::string date;
+    std::string time;
+    std::string reason;                  // why the request could not be assigned
+};
+
+// Assigns doctors and slots to a batch of requests and books them in the
+// Hospital. Each day is split into fixed slots; requests are served earliest
+// deadline first and, unless the preferred doctor is free, go to the least
+// loaded doctor of the requested specialty who has a free slot in the window.
+// Existing appointments are assumed to last one slot; a slot is only offered
+// if neither the doctor nor the patient has anything overlapping it.
+class Scheduler {
+private:
+    Hospital &hosp;
+    int dayStart;       // minutes after midnight
+    int slotMinutes;
+    int slotsPerDay;
+
+    // Bitmask of the slots overlapped by a one-slot-long appointment starting
+    // at `minute` (off-grid times overlap two slots)
+    std::uint64_t overlapMask(int minute) const;
+
+public:
+    // At most 64 slots per day. Throws std::invalid_argument otherwise.
+    explicit Scheduler(Hospital &hosp,
+                       const std::string &dayStart = "09:00",
+                       const std::string &dayEnd = "17:00",
+                       int slotMinutes = 15);
+
+    // Results are returned in request order
+    std::vector<ScheduleResult> schedule(const std::vector<ScheduleRequest> &batch);
+};
@@ -4,30 +4,58 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
+#include <utility>
+#include <cstring>
+#include <charconv>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace CSV {
 
-    // Split a CSV line into fields. Very simple quoted-field handling:
+    // Split a CSV line into fields. Simple quoted-field handling:
     // - Fields may be enclosed in double quotes.
-    // - Double quotes inside quoted field are not handled (kept simple for school project).
+    // - A doubled quote ("") inside a quoted field is a literal quote (as written by Writer).
+    // - Quoted fields may contain newlines; readCSV joins such records before splitting.
+    // - Whitespace outside quotes is trimmed; quoted content is kept verbatim.
     std::vector<std::string> split(const std::string &line, char delimiter) {
         std::vector<std::string> result;
         std::string cur;
+        size_t keep = 0; // leading part of `cur` that came from quotes and must not be trimmed
         bool inQuotes = false;
+        auto isSpace = [](char ch) { return std::isspace(static_cast<unsigned char>(ch)) != 0; };
+        auto finish = [&]() {
+            while (cur.size() > keep && isSpace(cur.back())) cur.pop_back();
+            result.push_back(cur);
+            cur.clear();
+            keep = 0;
+        };
         for (size_t i = 0; i < line.size(); ++i) {
             char ch = line[i];
             if (ch == '"') {
-                inQuotes = !inQuotes;
+                if (inQuotes && i + 1 < line.size() && line[i + 1] == '"') {
+                    cur.push_back('"');
+                    ++i;
+                } else {
+                    inQuotes = !inQuotes;
+                }
+                keep = cur.size();
                 continue;
             }
             if (ch == delimiter && !inQuotes) {
-                result.push_back(cur);
-                cur.clear();
-            } else {
+                finish();
+            } else if (inQuotes || !cur.empty() || !isSpace(ch)) {
                 cur.push_back(ch);
+                if (inQuotes) keep = cur.size();
             }
         }
-        result.push_back(cur);
+        finish();
         return result;
     }
 
@@ -49,11 +77,16 @@ namespace CSV {
         bool first = true;
 
         while (std::getline(file, line)) {
+            // a quoted field may span lines: keep reading while a quote is open
+            // (an odd number of '"' so far, since escaped quotes come in pairs)
+            std::string more;
+            while (std::count(line.begin(), line.end(), '"') % 2 != 0 && std::getline(file, more)) {
+                line.push_back('\n');
+                line += more;
+            }
             if (first) { first = false; continue; } // skip header
             if (line.empty()) continue;
-            auto parts = split(line, ',');
-            for (auto &p : parts) p = trim(p);
-            rows.push_back(parts);
+            rows.push_back(split(line, ','));
         }
         return rows;
     }
@@ -61,25 +94,165 @@ namespace CSV {
     void writeCSV(const std::string &filename,
                   const std::vector<std::string> &header,
                   const std::vector<std::vector<std::string>> &rows) {
-        std::ofstream file(filename);
-        if (!file.is_open()) throw std::runtime_error("Cannot write to file: " + filename);
+        Writer w(filename);
+        for (const auto &h : header) w.field(h);
+        w.endRow();
+        for (const auto &row : rows) {
+            for (const auto &f : row) w.field(f);
+            w.endRow();
+        }
+        w.commit();
+    }
+
+    // --------------------------------------------------
+    //  Writer
+    // --------------------------------------------------
 
-        for (size_t i = 0; i < header.size(); ++i) {
-            file << header[i];
-            if (i + 1 < header.size()) file << ",";
+    namespace {
+#ifdef _WIN32
+        int openTemp(const std::string &p) { return ::_open(p.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644); }
+        long writeSome(int fd, const char *d, std::size_t n) { return ::_write(fd, d, static_cast<unsigned>(n)); }
+        int syncFile(int fd) { return ::_commit(fd); }
+        int closeFd(int fd) { return ::_close(fd); }
+        bool replaceFile(const std::string &from, const std::string &to) {
+            return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
         }
-        file << "\n";
+        void syncDir(const std::string &) {}
+#else
+        int openTemp(const std::string &p) { return ::open(p.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644); }
+        long writeSome(int fd, const char *d, std::size_t n) { return static_cast<long>(::write(fd, d, n)); }
+        int syncFile(int fd) { return ::fsync(fd); }
+        int closeFd(int fd) { return ::close(fd); }
+        bool replaceFile(const std::string &from, const std::string &to) {
+            return std::rename(from.c_str(), to.c_str()) == 0;
+        }
+        // make the rename itself durable (best effort)
+        void syncDir(const std::string &file) {
+            auto slash = file.find_last_of('/');
+            std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : file.substr(0, slash));
+            int dfd = ::open(dir.c_str(), O_RDONLY);
+            if (dfd < 0) return;
+            ::fsync(dfd);
+            ::close(dfd);
+        }
+#endif
+    }
 
-        for (const auto &row : rows) {
-            for (size_t i = 0; i < row.size(); ++i) {
-                // quote if contains comma
-                bool needQuote = row[i].find(',') != std::string::npos;
-                if (needQuote) file << '"';
-                file << row[i];
-                if (needQuote) file << '"';
-                if (i + 1 < row.size()) file << ",";
+    Writer::Writer(const std::string &filename, std::size_t bufferSize)
+        : path(filename), tmpPath(filename + ".tmp"), buf(bufferSize < 64 ? 64 : bufferSize) {
+        fd = openTemp(tmpPath);
+        if (fd < 0) throw std::runtime_error("Cannot write to file: " + filename);
+    }
+
+    Writer::~Writer() {
+        if (fd >= 0) {
+            closeFd(fd);
+            std::remove(tmpPath.c_str());
+        }
+    }
+
+    void Writer::flush() {
+        std::size_t off = 0;
+        while (off < used) {
+            long n = writeSome(fd, buf.data() + off, used - off);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Write failed: " + tmpPath);
             }
-            file << "\n";
+            off += static_cast<std::size_t>(n);
+        }
+        used = 0;
+    }
+
+    void Writer::put(const char *data, std::size_t n) {
+        if (used + n > buf.size()) {
+            flush();
+            if (n > buf.size()) { // larger than the whole buffer: write through
+                while (n > 0) {
+                    std::size_t chunk = std::min(n, buf.size());
+                    std::memcpy(buf.data(), data, chunk);
+                    used = chunk;
+                    flush();
+                    data += chunk;
+                    n -= chunk;
+                }
+                return;
+            }
+        }
+        std::memcpy(buf.data() + used, data, n);
+        used += n;
+    }
+
+    void Writer::separator() {
+        if (!rowStart) put(",", 1);
+        rowStart = false;
+    }
+
+    Writer &Writer::field(std::string_view s) {
+        separator();
+        // One pass classifies the field, stopping at the first quote. The field is
+        // then copied verbatim, or in runs between quotes when they must be doubled.
+        // Leading/trailing whitespace is quoted too, since readCSV trims unquoted text.
+        auto isSpace = [](char ch) { return std::isspace(static_cast<unsigned char>(ch)) != 0; };
+        bool needQuote = !s.empty() && (isSpace(s.front()) || isSpace(s.back()));
+        std::size_t firstQuote = std::string_view::npos;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            char ch = s[i];
+            if (ch == '"') { firstQuote = i; needQuote = true; break; }
+            if (ch == ',' || ch == '\n' || ch == '\r') needQuote = true;
+        }
+        if (!needQuote) {
+            put(s.data(), s.size());
+            return *this;
+        }
+        put("\"", 1);
+        std::size_t start = 0;
+        for (std::size_t j = firstQuote; j != std::string_view::npos; j = s.find('"', j + 1)) {
+            put(s.data() + start, j + 1 - start);
+            put("\"", 1);
+            start = j + 1;
+        }
+        put(s.data() + start, s.size() - start);
+        put("\"", 1);
+        return *this;
+    }
+
+    Writer &Writer::field(long long v) {
+        separator();
+        char tmp[24];
+        auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+        put(tmp, static_cast<std::size_t>(res.ptr - tmp));
+        return *this;
+    }
+
+    void Writer::endRow() {
+        put("\n", 1);
+        rowStart = true;
+    }
+
+    void Writer::row(std::initializer_list<std::string_view> fields) {
+        for (auto f : fields) field(f);
+        endRow();
+    }
+
+    void Writer::closeFile() {
+        int f = fd;
+        fd = -1;
+        if (closeFd(f) != 0) {
+            std::remove(tmpPath.c_str());
+            throw std::runtime_error("Close failed: " + tmpPath);
+        }
+    }
+
+    void Writer::commit() {
+        if (fd < 0) throw std::runtime_error("Writer already committed: " + path);
+        flush();
+        if (syncFile(fd) != 0) throw std::runtime_error("fsync failed: " + tmpPath);
+        closeFile();
+        if (!replaceFile(tmpPath, path)) {
+            std::remove(tmpPath.c_str());
+            throw std::runtime_error("Cannot replace file: " + path);
         }
+        syncDir(path);
     }
 }
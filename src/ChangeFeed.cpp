@@ -0,0 +1,91 @@
+#include "ChangeFeed.h"
+#include <stdexcept>
+
+namespace {
+    std::size_t roundUpPow2(std::size_t n) {
+        std::size_t c = 1;
+        while (c < n) c <<= 1;
+        return c;
+    }
+}
+
+ChangeFeed::ChangeFeed(std::size_t capacity) {
+    if (capacity == 0) throw std::invalid_argument("ChangeFeed capacity must be positive");
+    ring = std::make_shared<Ring>(roundUpPow2(capacity));
+}
+
+void ChangeFeed::publish(Table t, Mutation kind, int id, std::uint64_t version) noexcept {
+    if (!ring) return; // moved from
+    const std::uint64_t n = ring->head.load(std::memory_order_relaxed);
+    Slot &s = ring->slots[n & ring->mask];
+
+    s.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.version.store(version, std::memory_order_relaxed);
+    s.payload.store(static_cast<std::uint32_t>(id)
+                    | static_cast<std::uint64_t>(t) << 32
+                    | static_cast<std::uint64_t>(kind) << 40,
+                    std::memory_order_relaxed);
+    s.seq.store(2 * n + 2, std::memory_order_release);
+
+    ring->head.store(n + 1, std::memory_order_release);
+}
+
+// Copies of a moved-from feed are detached too
+ChangeFeed::ChangeFeed(const ChangeFeed &o) : ring(o.ring ? std::make_shared<Ring>(o.capacity()) : nullptr) {}
+
+ChangeFeed &ChangeFeed::operator=(const ChangeFeed &o) {
+    if (this != &o) ring = o.ring ? std::make_shared<Ring>(o.capacity()) : nullptr;
+    return *this;
+}
+
+ChangeFeed::Cursor ChangeFeed::subscribe() const {
+    if (!ring) { // moved from: a ring nothing will ever publish to
+        static const std::shared_ptr<const Ring> detached = std::make_shared<Ring>(1);
+        return Cursor(detached, 0);
+    }
+    return Cursor(ring, ring->head.load(std::memory_order_acquire));
+}
+
+std::optional<MutationEvent> ChangeFeed::Cursor::poll() {
+    const std::uint64_t capacity = ring->mask + 1;
+    while (true) {
+        const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (next >= head) return std::nullopt;
+        if (head - next > maxLag) maxLag = head - next;
+        if (head - next > capacity) { // lapped by the producer
+            dropped += head - capacity - next;
+            next = head - capacity;
+        }
+
+        const Slot &s = ring->slots[next & ring->mask];
+        const std::uint64_t seq = s.seq.load(std::memory_order_acquire);
+        if (seq != 2 * next + 2) { // being overwritten by a newer event
+            ++dropped;
+            ++next;
+            continue;
+        }
+        const std::uint64_t version = s.version.load(std::memory_order_relaxed);
+        const std::uint64_t payload = s.payload.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.seq.load(std::memory_order_relaxed) != seq) {
+            ++dropped;
+            ++next;
+            continue;
+        }
+
+        MutationEvent ev;
+        ev.sequence = next++;
+        ev.version = version;
+        ev.id = static_cast<int>(static_cast<std::uint32_t>(payload));
+        ev.table = static_cast<Table>((payload >> 32) & 0xff);
+        ev.kind = static_cast<Mutation>((payload >> 40) & 0xff);
+        ++delivered;
+        return ev;
+    }
+}
+
+ChangeFeed::Cursor::Stats ChangeFeed::Cursor::stats() const noexcept {
+    const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+    return Stats{delivered, dropped, head > next ? head - next : 0, maxLag};
+}
@@ -0,0 +1,161 @@
+#include "CompactRecords.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+static_assert(sizeof(CompactPatientTable::Record) == 24, "patient record should stay 24 bytes");
+static_assert(sizeof(CompactDoctorTable::Record) == 24, "doctor record should stay 24 bytes");
+
+// --------------------------------------------------
+//  STRING HEAP
+// --------------------------------------------------
+
+void StringHeap::rebuildIndex() {
+    index.clear();
+    index.reserve(strings.size());
+    for (std::size_t i = 0; i < strings.size(); ++i)
+        index.emplace(strings[i], static_cast<std::uint32_t>(i));
+}
+
+StringHeap &StringHeap::operator=(const StringHeap &o) {
+    if (this != &o) {
+        strings = o.strings;
+        rebuildIndex();
+    }
+    return *this;
+}
+
+std::uint32_t StringHeap::intern(std::string_view s) {
+    auto it = index.find(s);
+    if (it != index.end()) return it->second;
+    auto id = static_cast<std::uint32_t>(strings.size());
+    strings.emplace_back(s);
+    index.emplace(strings.back(), id); // view into the deque element, which never moves
+    return id;
+}
+
+// --------------------------------------------------
+//  FIELD PACKING
+// --------------------------------------------------
+
+namespace Compact {
+
+    // packed contact: bit 63 = interned, bits 56..59 = digit count, bits 0..55 = value
+    static const std::uint64_t kInterned = 1ULL << 63;
+    static const int kLengthShift = 56;
+    static const std::size_t kMaxDigits = 15;
+
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+            return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+        });
+    }
+
+    Gender parseGender(std::string_view s) {
+        if (s.empty()) return Gender::Unknown;
+        if (equalsIgnoreCase(s, "M") || equalsIgnoreCase(s, "Male")) return Gender::Male;
+        if (equalsIgnoreCase(s, "F") || equalsIgnoreCase(s, "Female")) return Gender::Female;
+        return Gender::Other;
+    }
+
+    const std::string &genderText(Gender g) {
+        static const std::string text[] = {"", "M", "F", "O"};
+        return text[static_cast<std::size_t>(g)];
+    }
+
+    std::uint64_t packContact(std::string_view s, StringHeap &heap) {
+        bool digits = s.size() <= kMaxDigits &&
+                      std::all_of(s.begin(), s.end(), [](char ch) { return ch >= '0' && ch <= '9'; });
+        if (!digits) return kInterned | heap.intern(s);
+
+        std::uint64_t value = 0;
+        for (char ch : s) value = value * 10 + static_cast<std::uint64_t>(ch - '0');
+        return (static_cast<std::uint64_t>(s.size()) << kLengthShift) | value;
+    }
+
+    std::string unpackContact(std::uint64_t packed, const StringHeap &heap) {
+        if (packed & kInterned) return heap.get(static_cast<std::uint32_t>(packed));
+
+        std::size_t len = static_cast<std::size_t>((packed >> kLengthShift) & 0xf);
+        std::uint64_t value = packed & ((1ULL << kLengthShift) - 1);
+        std::string out(len, '0');
+        for (std::size_t i = len; i > 0 && value; --i, value /= 10)
+            out[i - 1] = static_cast<char>('0' + value % 10);
+        return out;
+    }
+}
+
+static std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+// Names are interned, so each distinct name is matched once per query
+template <class Table, class View>
+static std::vector<View> searchNames(const Table &table, const std::string &q) {
+    const std::string lowq = toLower(q);
+    std::vector<signed char> matched(table.getHeap().size(), -1); // -1 = not checked yet
+    std::vector<View> out;
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        std::uint32_t name = table.getRecords()[i].name;
+        if (matched[name] < 0)
+            matched[name] = toLower(table.getHeap().get(name)).find(lowq) != std::string::npos;
+        if (matched[name]) out.push_back(table[i]);
+    }
+    return out;
+}
+
+// --------------------------------------------------
+//  PATIENTS
+// --------------------------------------------------
+
+CompactPatientTable::CompactPatientTable(const std::vector<Patient> &patients) {
+    records.reserve(patients.size());
+    for (const auto &p : patients) add(p);
+}
+
+void CompactPatientTable::add(const Patient &p) {
+    add(p.getId(), p.getName(), p.getAge(), p.getGender(), p.getContact());
+}
+
+void CompactPatientTable::add(int id, std::string_view name, int age, std::string_view gender, std::string_view contact) {
+    if (age < 0 || age > 255) throw std::invalid_argument("Age out of range for compact record");
+    Record r;
+    r.contact = Compact::packContact(contact, heap);
+    r.id = id;
+    r.name = heap.intern(name);
+    r.age = static_cast<std::uint8_t>(age);
+    r.gender = Compact::parseGender(gender);
+    r.genderSpelling = gender == Compact::genderText(r.gender) ? kCanonical : heap.intern(gender);
+    records.push_back(r);
+}
+
+std::vector<CompactPatientTable::View> CompactPatientTable::searchByName(const std::string &q) const {
+    return searchNames<CompactPatientTable, View>(*this, q);
+}
+
+// --------------------------------------------------
+//  DOCTORS
+// --------------------------------------------------
+
+CompactDoctorTable::CompactDoctorTable(const std::vector<Doctor> &doctors) {
+    records.reserve(doctors.size());
+    for (const auto &d : doctors) add(d);
+}
+
+void CompactDoctorTable::add(const Doctor &d) {
+    add(d.getId(), d.getName(), d.getSpecialty(), d.getContact());
+}
+
+void CompactDoctorTable::add(int id, std::string_view name, std::string_view specialty, std::string_view contact) {
+    Record r;
+    r.contact = Compact::packContact(contact, heap);
+    r.id = id;
+    r.name = heap.intern(name);
+    r.specialty = heap.intern(specialty);
+    records.push_back(r);
+}
+
+std::vector<CompactDoctorTable::View> CompactDoctorTable::searchByName(const std::string &q) const {
+    return searchNames<CompactDoctorTable, View>(*this, q);
+}
@@ -0,0 +1,69 @@
+#include "DateTime.h"
+#include <charconv>
+#include <cstdio>
+
+namespace DateTime {
+
+    namespace {
+        bool parseFixed(std::string_view s, int &out) {
+            if (s.empty()) return false;
+            for (char ch : s) if (ch < '0' || ch > '9') return false;
+            return std::from_chars(s.data(), s.data() + s.size(), out).ec == std::errc();
+        }
+
+        bool isLeap(int y) { return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0; }
+
+        int daysInMonth(int y, int m) {
+            static const int dim[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+            return m == 2 && isLeap(y) ? 29 : dim[m - 1];
+        }
+    }
+
+    // civil <-> serial day conversion (proleptic Gregorian, H. Hinnant's algorithm)
+    bool parseDate(std::string_view s, int &days) {
+        if (s.size() != 10 || s[4] != '-' || s[7] != '-') return false;
+        int y, m, d;
+        if (!parseFixed(s.substr(0, 4), y) || !parseFixed(s.substr(5, 2), m) || !parseFixed(s.substr(8, 2), d))
+            return false;
+        if (m < 1 || m > 12 || d < 1 || d > daysInMonth(y, m)) return false;
+
+        y -= m <= 2;
+        const int era = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        days = era * 146097 + static_cast<int>(doe) - 719468;
+        return true;
+    }
+
+    std::string formatDate(int days) {
+        days += 719468;
+        const int era = (days >= 0 ? days : days - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(days - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+        const int y = static_cast<int>(yoe) + era * 400 + (m <= 2);
+
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%04d-%02u-%02u", y, m, d);
+        return buf;
+    }
+
+    bool parseTime(std::string_view s, int &minutes) {
+        if (s.size() != 5 || s[2] != ':') return false;
+        int h, m;
+        if (!parseFixed(s.substr(0, 2), h) || !parseFixed(s.substr(3, 2), m)) return false;
+        if (h > 23 || m > 59) return false;
+        minutes = h * 60 + m;
+        return true;
+    }
+
+    std::string formatTime(int minutes) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "%02d:%02d", (minutes / 60) % 100, minutes % 60);
+        return buf;
+    }
+}
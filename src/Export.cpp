@@ -0,0 +1,561 @@
+#include "Export.h"
+#include "DateTime.h"
+#include "CSVUtils.h"
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
+
+// Columnar export
+// ---------------
+// Binary layout (all integers are LEB128 varints, signed ones zigzag-encoded):
+//
+//   "HCX2" epoch version since                     -- since 0 means every table is a reset
+//   per table:  tag(1 byte: 1=patients 2=doctors 3=appointments 4=billing) flags(1 byte: 1=reset)
+//               blocks...  0                       -- each block starts with its row count
+//               deletedCount deletedIdDeltas...
+//   0                                              -- end of stream
+//
+//   block:      rows columnCount column...
+//   column:     nameLen name enc(1 byte) payload
+//     Int      rows x signed value
+//     Delta    rows x signed difference from the previous row (first from 0)
+//     Dict     dictSize dictSize x (len bytes), rows x index
+//     Raw      rows x (len bytes)
+//     Days     like Delta, values are days since 1970-01-01
+//     Minutes  rows x minutes after midnight
+//
+// Dates and times that do not parse fall back to Dict for that block.
+// The JSON variant carries the same blocks and encodings with names instead
+// of tags; deleted IDs are listed as-is, and the epoch is a decimal string
+// because it does not fit in a JavaScript number.
+
+namespace Export {
+
+    namespace {
+
+        enum class Enc : unsigned char { Int = 1, Delta = 2, Dict = 3, Raw = 4, Days = 5, Minutes = 6 };
+
+        const char *encName(Enc e) {
+            switch (e) {
+                case Enc::Int:     return "int";
+                case Enc::Delta:   return "delta";
+                case Enc::Dict:    return "dict";
+                case Enc::Raw:     return "raw";
+                case Enc::Days:    return "days";
+                case Enc::Minutes: return "minutes";
+            }
+            return "";
+        }
+
+        struct Column {
+            const char *name;
+            Enc enc;
+            std::vector<long long> values;      // Int/Delta/Days/Minutes values, Dict indices
+            std::vector<std::string_view> strs; // Dict entries or Raw values
+        };
+
+        // How a column is produced from an entity
+        enum class Kind { Id, Int, Category, Text, Date, Time };
+
+        template <class Row>
+        struct ColumnSpec {
+            const char *name;
+            Kind kind;
+            long long (*intOf)(const Row &);
+            std::string_view (*strOf)(const Row &);
+        };
+
+        template <class Row>
+        void encodeDict(Column &c, const std::vector<const Row *> &rows, std::string_view (*strOf)(const Row &)) {
+            c.enc = Enc::Dict;
+            std::unordered_map<std::string_view, long long> index;
+            for (const Row *r : rows) {
+                auto s = strOf(*r);
+                auto [it, inserted] = index.try_emplace(s, static_cast<long long>(c.strs.size()));
+                if (inserted) c.strs.push_back(s);
+                c.values.push_back(it->second);
+            }
+        }
+
+        template <class Row>
+        Column encode(const ColumnSpec<Row> &spec, const std::vector<const Row *> &rows) {
+            Column c{spec.name, Enc::Int, {}, {}};
+            c.values.reserve(rows.size());
+            switch (spec.kind) {
+                case Kind::Id: {
+                    c.enc = Enc::Delta;
+                    long long prev = 0;
+                    for (const Row *r : rows) {
+                        long long v = spec.intOf(*r);
+                        c.values.push_back(v - prev);
+                        prev = v;
+                    }
+                    break;
+                }
+                case Kind::Int:
+                    for (const Row *r : rows) c.values.push_back(spec.intOf(*r));
+                    break;
+                case Kind::Category:
+                    encodeDict(c, rows, spec.strOf);
+                    break;
+                case Kind::Text:
+                    c.enc = Enc::Raw;
+                    c.strs.reserve(rows.size());
+                    for (const Row *r : rows) c.strs.push_back(spec.strOf(*r));
+                    break;
+                case Kind::Date: {
+                    c.enc = Enc::Days;
+                    long long prev = 0;
+                    for (const Row *r : rows) {
+                        int days = 0;
+                        if (!DateTime::parseDate(spec.strOf(*r), days)) {
+                            c.values.clear();
+                            encodeDict(c, rows, spec.strOf);
+                            break;
+                        }
+                        c.values.push_back(days - prev);
+                        prev = days;
+                    }
+                    break;
+                }
+                case Kind::Time: {
+                    c.enc = Enc::Minutes;
+                    for (const Row *r : rows) {
+                        int minutes = 0;
+                        if (!DateTime::parseTime(spec.strOf(*r), minutes)) {
+                            c.values.clear();
+                            encodeDict(c, rows, spec.strOf);
+                            break;
+                        }
+                        c.values.push_back(minutes);
+                    }
+                    break;
+                }
+            }
+            return c;
+        }
+
+        // --------------------------------------------------
+        //  Output sinks
+        // --------------------------------------------------
+
+        class Sink {
+        public:
+            virtual ~Sink() = default;
+            virtual void begin(std::uint64_t epoch, std::uint64_t version, std::uint64_t since) = 0;
+            virtual void beginTable(Table t, const char *name, bool reset) = 0;
+            virtual void block(std::size_t rows, const std::vector<Column> &cols) = 0;
+            virtual void endTable(const std::vector<int> &deleted) = 0;
+            virtual void end() = 0;
+        };
+
+        class BinarySink : public Sink {
+        private:
+            std::ostream &out;
+            std::string buf;
+
+            void varint(unsigned long long v) {
+                while (v >= 0x80) {
+                    buf.push_back(static_cast<char>((v & 0x7f) | 0x80));
+                    v >>= 7;
+                }
+                buf.push_back(static_cast<char>(v));
+            }
+            void svarint(long long v) {
+                varint((static_cast<unsigned long long>(v) << 1) ^ static_cast<unsigned long long>(v >> 63));
+            }
+            void str(std::string_view s) {
+                varint(s.size());
+                buf.append(s.data(), s.size());
+            }
+            void flush() {
+                out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+                buf.clear();
+            }
+
+        public:
+            explicit BinarySink(std::ostream &out) : out(out) {}
+
+            void begin(std::uint64_t epoch, std::uint64_t version, std::uint64_t since) override {
+                buf.append("HCX2", 4);
+                varint(epoch);
+                varint(version);
+                varint(since);
+            }
+
+            void beginTable(Table t, const char *, bool reset) override {
+                buf.push_back(static_cast<char>(static_cast<int>(t) + 1));
+                buf.push_back(static_cast<char>(reset ? 1 : 0));
+            }
+
+            void block(std::size_t rows, const std::vector<Column> &cols) override {
+                varint(rows);
+                varint(cols.size());
+                for (const auto &c : cols) {
+                    str(c.name);
+                    buf.push_back(static_cast<char>(c.enc));
+                    if (c.enc == Enc::Dict) {
+                        varint(c.strs.size());
+                        for (auto s : c.strs) str(s);
+                        for (auto v : c.values) varint(static_cast<unsigned long long>(v));
+                    } else if (c.enc == Enc::Raw) {
+                        for (auto s : c.strs) str(s);
+                    } else {
+                        for (auto v : c.values) svarint(v);
+                    }
+                }
+                flush();
+            }
+
+            void endTable(const std::vector<int> &deleted) override {
+                varint(0);
+                varint(deleted.size());
+                long long prev = 0;
+                for (int id : deleted) {
+                    svarint(id - prev);
+                    prev = id;
+                }
+                flush();
+            }
+
+            void end() override {
+                buf.push_back(0);
+                flush();
+            }
+        };
+
+        class JsonSink : public Sink {
+        private:
+            std::ostream &out;
+            bool firstTable = true;
+            bool firstBlock = true;
+
+            void str(std::string_view s) {
+                out << '"';
+                for (char ch : s) {
+                    switch (ch) {
+                        case '"':  out << "\\\""; break;
+                        case '\\': out << "\\\\"; break;
+                        case '\n': out << "\\n"; break;
+                        case '\r': out << "\\r"; break;
+                        case '\t': out << "\\t"; break;
+                        default:
+                            if (static_cast<unsigned char>(ch) < 0x20) {
+                                char esc[8];
+                                std::snprintf(esc, sizeof(esc), "\\u%04x", static_cast<unsigned>(ch));
+                                out << esc;
+                            } else {
+                                out << ch;
+                            }
+                    }
+                }
+                out << '"';
+            }
+
+            template <class T, class F>
+            void array(const std::vector<T> &v, F each) {
+                out << '[';
+                for (std::size_t i = 0; i < v.size(); ++i) {
+                    if (i) out << ',';
+                    each(v[i]);
+                }
+                out << ']';
+            }
+
+        public:
+            explicit JsonSink(std::ostream &out) : out(out) {}
+
+            void begin(std::uint64_t epoch, std::uint64_t version, std::uint64_t since) override {
+                out << "{\"format\":\"hospital-columnar/2\",\"epoch\":\"" << epoch
+                    << "\",\"version\":" << version
+                    << ",\"since\":" << since << ",\"tables\":{";
+            }
+
+            void beginTable(Table, const char *name, bool reset) override {
+                if (!firstTable) out << ',';
+                firstTable = false;
+                firstBlock = true;
+                out << '"' << name << "\":{\"reset\":" << (reset ? "true" : "false") << ",\"blocks\":[";
+            }
+
+            void block(std::size_t rows, const std::vector<Column> &cols) override {
+                if (!firstBlock) out << ',';
+                firstBlock = false;
+                out << "{\"rows\":" << rows << ",\"columns\":{";
+                for (std::size_t i = 0; i < cols.size(); ++i) {
+                    const auto &c = cols[i];
+                    if (i) out << ',';
+                    out << '"' << c.name << "\":{\"enc\":\"" << encName(c.enc) << '"';
+                    if (c.enc == Enc::Dict) {
+                        out << ",\"dict\":";
+                        array(c.strs, [&](std::string_view s) { str(s); });
+                    }
+                    out << ",\"data\":";
+                    if (c.enc == Enc::Raw) array(c.strs, [&](std::string_view s) { str(s); });
+                    else array(c.values, [&](long long v) { out << v; });
+                    out << '}';
+                }
+                out << "}}";
+            }
+
+            void endTable(const std::vector<int> &deleted) override {
+                out << "],\"deleted\":";
+                array(deleted, [&](int id) { out << id; });
+                out << '}';
+            }
+
+            void end() override {
+                out << "}}\n";
+            }
+        };
+
+        // Forwards stream output to a CSV::Writer (which does its own buffering)
+        class WriterBuf : public std::streambuf {
+        private:
+            CSV::Writer &w;
+
+        protected:
+            int_type overflow(int_type ch) override {
+                if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                    char c = traits_type::to_char_type(ch);
+                    w.raw(std::string_view(&c, 1));
+                }
+                return traits_type::not_eof(ch);
+            }
+            std::streamsize xsputn(const char *s, std::streamsize n) override {
+                w.raw(std::string_view(s, static_cast<std::size_t>(n)));
+                return n;
+            }
+
+        public:
+            explicit WriterBuf(CSV::Writer &w) : w(w) {}
+        };
+
+        // Reads the primitives BinarySink writes; any short read is malformed input
+        class Reader {
+        private:
+            std::istream &in;
+
+            [[noreturn]] static void fail(const char *what) {
+                throw std::runtime_error(std::string("Malformed export: ") + what);
+            }
+
+        public:
+            explicit Reader(std::istream &in) : in(in) {}
+
+            unsigned char byte() {
+                char c;
+                if (!in.get(c)) fail("unexpected end of stream");
+                return static_cast<unsigned char>(c);
+            }
+            unsigned long long varint() {
+                unsigned long long v = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    unsigned char b = byte();
+                    v |= static_cast<unsigned long long>(b & 0x7f) << shift;
+                    if (!(b & 0x80)) return v;
+                }
+                fail("varint too long");
+            }
+            long long svarint() {
+                unsigned long long v = varint();
+                return static_cast<long long>(v >> 1) ^ -static_cast<long long>(v & 1);
+            }
+            // varint that sizes something; guards against huge allocations from bad input
+            std::size_t count(std::size_t limit, const char *what) {
+                unsigned long long n = varint();
+                if (n > limit) fail(what);
+                return static_cast<std::size_t>(n);
+            }
+            std::string str() {
+                std::size_t n = count(1u << 20, "string too long");
+                std::string s(n, '\0');
+                if (n && !in.read(&s[0], static_cast<std::streamsize>(n))) fail("unexpected end of stream");
+                return s;
+            }
+            static void check(bool ok, const char *what) {
+                if (!ok) fail(what);
+            }
+        };
+
+        // Decodes one block column into its CSV text, one entry per row
+        std::vector<std::string> readColumn(Reader &r, Enc enc, std::size_t rows) {
+            std::vector<std::string> out;
+            out.reserve(rows);
+            long long prev = 0;
+            switch (enc) {
+                case Enc::Int:
+                    for (std::size_t i = 0; i < rows; ++i) out.push_back(std::to_string(r.svarint()));
+                    break;
+                case Enc::Delta:
+                    for (std::size_t i = 0; i < rows; ++i) out.push_back(std::to_string(prev += r.svarint()));
+                    break;
+                case Enc::Dict: {
+                    std::vector<std::string> dict(r.count(rows, "dictionary larger than block"));
+                    for (auto &d : dict) d = r.str();
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        unsigned long long idx = r.varint();
+                        Reader::check(idx < dict.size(), "dictionary index out of range");
+                        out.push_back(dict[idx]);
+                    }
+                    break;
+                }
+                case Enc::Raw:
+                    for (std::size_t i = 0; i < rows; ++i) out.push_back(r.str());
+                    break;
+                case Enc::Days:
+                    for (std::size_t i = 0; i < rows; ++i)
+                        out.push_back(DateTime::formatDate(static_cast<int>(prev += r.svarint())));
+                    break;
+                case Enc::Minutes:
+                    for (std::size_t i = 0; i < rows; ++i)
+                        out.push_back(DateTime::formatTime(static_cast<int>(r.svarint())));
+                    break;
+                default:
+                    Reader::check(false, "unknown column encoding");
+            }
+            return out;
+        }
+
+        // --------------------------------------------------
+        //  Table export
+        // --------------------------------------------------
+
+        template <class Row, class IdOf>
+        void exportTable(Sink &sink, const Hospital &h, Table t, const char *name,
+                         const std::vector<Row> &rows, IdOf idOf,
+                         const std::vector<ColumnSpec<Row>> &specs, std::uint64_t since) {
+            bool reset = since == 0 || since < h.getResetVersion(t);
+            sink.beginTable(t, name, reset);
+
+            std::vector<const Row *> batch;
+            batch.reserve(std::min(rows.size(), kBlockRows));
+            std::vector<Column> cols;
+            auto emit = [&]() {
+                cols.clear();
+                for (const auto &spec : specs) cols.push_back(encode(spec, batch));
+                sink.block(batch.size(), cols);
+                batch.clear();
+            };
+
+            for (const auto &r : rows) {
+                if (!reset && h.getRowVersion(t, idOf(r)) <= since) continue;
+                batch.push_back(&r);
+                if (batch.size() == kBlockRows) emit();
+            }
+            if (!batch.empty()) emit();
+
+            sink.endTable(reset ? std::vector<int>() : h.getDeletedSince(t, since));
+        }
+    }
+
+    Position write(const Hospital &h, std::ostream &out, Format fmt, Position from) {
+        std::unique_ptr<Sink> sink;
+        if (fmt == Format::Json) sink = std::make_unique<JsonSink>(out);
+        else sink = std::make_unique<BinarySink>(out);
+
+        const Position now{h.getEpoch(), h.getVersion()};
+        // A version from another epoch, or one we have not reached, says nothing
+        // about what the consumer holds: start it over from a full snapshot.
+        const std::uint64_t since = from.epoch == now.epoch && from.version <= now.version ? from.version : 0;
+        sink->begin(now.epoch, now.version, since);
+
+        exportTable<Patient>(*sink, h, Table::Patients, "patients", h.getAllPatients(),
+            [](const Patient &p) { return p.getId(); }, {
+                {"id",      Kind::Id,       [](const Patient &p) -> long long { return p.getId(); }, nullptr},
+                {"name",    Kind::Text,     nullptr, [](const Patient &p) -> std::string_view { return p.getName(); }},
+                {"age",     Kind::Int,      [](const Patient &p) -> long long { return p.getAge(); }, nullptr},
+                {"gender",  Kind::Category, nullptr, [](const Patient &p) -> std::string_view { return p.getGender(); }},
+                {"contact", Kind::Text,     nullptr, [](const Patient &p) -> std::string_view { return p.getContact(); }},
+            }, since);
+
+        exportTable<Doctor>(*sink, h, Table::Doctors, "doctors", h.getAllDoctors(),
+            [](const Doctor &d) { return d.getId(); }, {
+                {"id",        Kind::Id,       [](const Doctor &d) -> long long { return d.getId(); }, nullptr},
+                {"name",      Kind::Text,     nullptr, [](const Doctor &d) -> std::string_view { return d.getName(); }},
+                {"specialty", Kind::Category, nullptr, [](const Doctor &d) -> std::string_view { return d.getSpecialty(); }},
+                {"contact",   Kind::Text,     nullptr, [](const Doctor &d) -> std::string_view { return d.getContact(); }},
+            }, since);
+
+        exportTable<Appointment>(*sink, h, Table::Appointments, "appointments", h.getAllAppointments(),
+            [](const Appointment &a) { return a.getId(); }, {
+                {"id",        Kind::Id,   [](const Appointment &a) -> long long { return a.getId(); }, nullptr},
+                {"patientId", Kind::Int,  [](const Appointment &a) -> long long { return a.getPatientId(); }, nullptr},
+                {"doctorId",  Kind::Int,  [](const Appointment &a) -> long long { return a.getDoctorId(); }, nullptr},
+                {"date",      Kind::Date, nullptr, [](const Appointment &a) -> std::string_view { return a.getDate(); }},
+                {"time",      Kind::Time, nullptr, [](const Appointment &a) -> std::string_view { return a.getTime(); }},
+            }, since);
+
+        exportTable<Billing>(*sink, h, Table::Billing, "billing", h.getAllBills(),
+            [](const Billing &b) { return b.getBillId(); }, {
+                {"billId",        Kind::Id,       [](const Billing &b) -> long long { return b.getBillId(); }, nullptr},
+                {"appointmentId", Kind::Int,      [](const Billing &b) -> long long { return b.getAppointmentId(); }, nullptr},
+                {"doctorId",      Kind::Int,      [](const Billing &b) -> long long { return b.getDoctorId(); }, nullptr},
+                {"amount",        Kind::Int,      [](const Billing &b) -> long long { return static_cast<long long>(b.getAmount()); }, nullptr},
+                {"description",   Kind::Category, nullptr, [](const Billing &b) -> std::string_view { return b.getDescription(); }},
+                {"date",          Kind::Date,     nullptr, [](const Billing &b) -> std::string_view { return b.getDate(); }},
+            }, since);
+
+        sink->end();
+        return now;
+    }
+
+    Position writeFile(const Hospital &h, const std::string &file, Format fmt, Position since) {
+        CSV::Writer w(file);
+        WriterBuf buf(w);
+        std::ostream out(&buf);
+        out.exceptions(std::ios::badbit); // rethrow write errors from the Writer
+        Position pos = write(h, out, fmt, since);
+        w.commit();
+        return pos;
+    }
+
+    Delta read(std::istream &in) {
+        Reader r(in);
+        char magic[4];
+        Reader::check(in.read(magic, 4) && std::string_view(magic, 4) == "HCX2", "bad magic");
+
+        Delta d;
+        d.position.epoch = r.varint();
+        d.position.version = r.varint();
+        d.since = r.varint();
+
+        for (unsigned tag = r.byte(); tag != 0; tag = r.byte()) {
+            Reader::check(tag <= d.tables.size(), "unknown table tag");
+            TableDelta &t = d.tables[tag - 1];
+            t.reset = (r.byte() & 1) != 0;
+
+            for (std::size_t rows = r.count(kBlockRows, "block too large"); rows != 0;
+                 rows = r.count(kBlockRows, "block too large")) {
+                std::size_t ncols = r.count(64, "too many columns");
+                std::vector<std::string> names(ncols);
+                std::vector<std::vector<std::string>> cols(ncols);
+                for (std::size_t c = 0; c < ncols; ++c) {
+                    names[c] = r.str();
+                    cols[c] = readColumn(r, static_cast<Enc>(r.byte()), rows);
+                }
+                if (t.columns.empty()) t.columns = std::move(names);
+                else Reader::check(t.columns == names, "columns differ between blocks");
+                for (std::size_t i = 0; i < rows; ++i) {
+                    std::vector<std::string> row;
+                    row.reserve(ncols);
+                    for (auto &col : cols) row.push_back(std::move(col[i]));
+                    t.rows.push_back(std::move(row));
+                }
+            }
+
+            long long prev = 0;
+            for (unsigned long long n = r.varint(); n != 0; --n)
+                t.deleted.push_back(static_cast<int>(prev += r.svarint()));
+        }
+        return d;
+    }
+}
@@ -6,6 +6,9 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <utility>
+#include <random>
+#include <chrono>
 
 // --------------------------------------------------
 //  INTERNAL BILLING FUNCTION (based on doctor specialty)
@@ -34,23 +37,118 @@ static double getConsultationFeeBase(const std::string &specialty) {
     return 500; // default
 }
 
+// --------------------------------------------------
+//  CHANGE TRACKING
+// --------------------------------------------------
+
+static std::size_t tableIndex(Table t) { return static_cast<std::size_t>(t); }
+
+std::uint64_t Hospital::newEpoch() {
+    thread_local std::mt19937_64 rng(std::random_device{}() ^
+        static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::uint64_t e = 0;
+    while (e == 0) e = rng(); // 0 means "no epoch" to export consumers
+    return e;
+}
+
+void Hospital::touch(Table t, int id, Mutation kind) {
+    changes[tableIndex(t)].rows[id] = ++version;
+    generations[tableIndex(t)] = version;
+    feed.publish(t, kind, id, version);
+}
+
+void Hospital::drop(Table t, int id) {
+    auto &c = changes[tableIndex(t)];
+    c.rows.erase(id);
+    c.deleted[id] = ++version;
+    generations[tableIndex(t)] = version;
+    feed.publish(t, Mutation::Delete, id, version);
+}
+
+void Hospital::resetTable(Table t) {
+    auto &c = changes[tableIndex(t)];
+    c.rows.clear();
+    c.deleted.clear();
+    c.resetVersion = ++version;
+    generations[tableIndex(t)] = version;
+    feed.publish(t, Mutation::Reload, 0, version);
+}
+
+std::uint64_t Hospital::getRowVersion(Table t, int id) const {
+    const auto &c = changes[tableIndex(t)];
+    auto it = c.rows.find(id);
+    return it != c.rows.end() ? it->second : c.resetVersion;
+}
+
+std::uint64_t Hospital::getResetVersion(Table t) const noexcept {
+    return changes[tableIndex(t)].resetVersion;
+}
+
+std::uint64_t Hospital::getGeneration(Table t) const noexcept {
+    return generations[tableIndex(t)];
+}
+
+std::vector<int> Hospital::getDeletedSince(Table t, std::uint64_t since) const {
+    std::vector<int> out;
+    for (const auto &[id, v] : changes[tableIndex(t)].deleted)
+        if (v > since) out.push_back(id);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// --------------------------------------------------
+//  INDEXES
+// --------------------------------------------------
+
+void Hospital::reindexPatients() {
+    patientIndex.clear();
+    patientIndex.reserve(patients.size());
+    for (std::size_t i = 0; i < patients.size(); ++i) patientIndex[patients[i].getId()] = i;
+}
+
+void Hospital::reindexDoctors() {
+    doctorIndex.clear();
+    doctorIndex.reserve(doctors.size());
+    for (std::size_t i = 0; i < doctors.size(); ++i) doctorIndex[doctors[i].getId()] = i;
+}
+
+void Hospital::reindexAppointments() {
+    appointmentIndex.clear();
+    bookedSlots.clear();
+    appointmentIndex.reserve(appointments.size());
+    bookedSlots.reserve(appointments.size());
+    for (std::size_t i = 0; i < appointments.size(); ++i) {
+        const auto &a = appointments[i];
+        appointmentIndex[a.getId()] = i;
+        bookedSlots.insert(SlotKey{a.getDoctorId(), a.getDate(), a.getTime()});
+    }
+}
+
 // --------------------------------------------------
 //  PATIENTS
 // --------------------------------------------------
 
-Patient Hospital::addPatient(const std::string &name, int age, const std::string &gender, const std::string &contact) {
-    Patient p(nextPatientId++, name, age, gender, contact);
-    patients.push_back(p);
-    return p;
+Patient Hospital::addPatient(std::string name, int age, std::string gender, std::string contact) {
+    emplacePatient(std::move(name), age, std::move(gender), std::move(contact));
+    return patients.back();
 }
 
-bool Hospital::editPatient(int id, const std::string &name, int age, const std::string &gender, const std::string &contact) {
+int Hospital::emplacePatient(std::string name, int age, std::string gender, std::string contact) {
+    int id = nextPatientId++;
+    patients.emplace_back(id, std::move(name), age, std::move(gender), std::move(contact));
+    patientIndex[id] = patients.size() - 1;
+    touch(Table::Patients, id, Mutation::Add);
+    return id;
+}
+
+bool Hospital::editPatient(int id, std::string name, int age, std::string gender, std::string contact) {
     for (auto &p : patients) {
         if (p.getId() == id) {
-            p.setName(name);
+            p.setName(std::move(name));
             p.setAge(age);
-            p.setGender(gender);
-            p.setContact(contact);
+            p.setGender(std::move(gender));
+            p.setContact(std::move(contact));
+            touch(Table::Patients, id, Mutation::Edit);
             return true;
         }
     }
@@ -61,48 +159,75 @@ bool Hospital::deletePatient(int id) {
     auto it = std::remove_if(patients.begin(), patients.end(), [&](const Patient &p){ return p.getId() == id; });
     if (it != patients.end()) {
         patients.erase(it, patients.end());
+        drop(Table::Patients, id);
         // also remove any appointments for this patient (simple cleanup)
+        std::vector<int> cancelled;
+        for (const auto &a : appointments)
+            if (a.getPatientId() == id) cancelled.push_back(a.getId());
         appointments.erase(std::remove_if(appointments.begin(), appointments.end(),
             [&](const Appointment &a){ return a.getPatientId() == id; }), appointments.end());
+        for (int aid : cancelled) drop(Table::Appointments, aid);
+        reindexPatients();
+        reindexAppointments();
         return true;
     }
     return false;
 }
 
 std::optional<Patient> Hospital::findPatientById(int id) const {
-    for (const auto &p : patients)
-        if (p.getId() == id) return p;
+    if (const Patient *p = findPatientPtr(id)) return *p;
     return std::nullopt;
 }
 
+const Patient *Hospital::findPatientPtr(int id) const {
+    auto it = patientIndex.find(id);
+    return it != patientIndex.end() ? &patients[it->second] : nullptr;
+}
+
+const std::vector<Patient> &Hospital::getAllPatients() const {
+    return patients;
+}
+
 std::vector<Patient> Hospital::searchPatientsByName(const std::string &q) const {
-    std::vector<Patient> out;
     std::string lowq = q;
     std::transform(lowq.begin(), lowq.end(), lowq.begin(), ::tolower);
+    const std::uint64_t gen = getGeneration(Table::Patients);
+    if (auto cached = patientSearches.get(lowq, gen)) return *cached;
+
+    std::vector<Patient> out;
     for (const auto &p : patients) {
         std::string n = p.getName();
         std::transform(n.begin(), n.end(), n.begin(), ::tolower);
         if (n.find(lowq) != std::string::npos) out.push_back(p);
     }
-    return out;
+    const std::size_t rows = out.size() + 1;
+    return *patientSearches.put(lowq, gen, std::move(out), rows);
 }
 
 // --------------------------------------------------
 //  DOCTORS
 // --------------------------------------------------
 
-Doctor Hospital::addDoctor(const std::string &name, const std::string &spec, const std::string &contact) {
-    Doctor d(nextDoctorId++, name, spec, contact);
-    doctors.push_back(d);
-    return d;
+Doctor Hospital::addDoctor(std::string name, std::string spec, std::string contact) {
+    emplaceDoctor(std::move(name), std::move(spec), std::move(contact));
+    return doctors.back();
+}
+
+int Hospital::emplaceDoctor(std::string name, std::string spec, std::string contact) {
+    int id = nextDoctorId++;
+    doctors.emplace_back(id, std::move(name), std::move(spec), std::move(contact));
+    doctorIndex[id] = doctors.size() - 1;
+    touch(Table::Doctors, id, Mutation::Add);
+    return id;
 }
 
-bool Hospital::editDoctor(int id, const std::string &name, const std::string &spec, const std::string &contact) {
+bool Hospital::editDoctor(int id, std::string name, std::string spec, std::string contact) {
     for (auto &d : doctors) {
         if (d.getId() == id) {
-            d.setName(name);
-            d.setSpecialty(spec);
-            d.setContact(contact);
+            d.setName(std::move(name));
+            d.setSpecialty(std::move(spec));
+            d.setContact(std::move(contact));
+            touch(Table::Doctors, id, Mutation::Edit);
             return true;
         }
     }
@@ -113,159 +238,234 @@ bool Hospital::deleteDoctor(int id) {
     auto it = std::remove_if(doctors.begin(), doctors.end(), [&](const Doctor &d){ return d.getId() == id; });
     if (it != doctors.end()) {
         doctors.erase(it, doctors.end());
+        drop(Table::Doctors, id);
         // remove appointments for that doctor
+        std::vector<int> cancelled;
+        for (const auto &a : appointments)
+            if (a.getDoctorId() == id) cancelled.push_back(a.getId());
         appointments.erase(std::remove_if(appointments.begin(), appointments.end(),
             [&](const Appointment &a){ return a.getDoctorId() == id; }), appointments.end());
+        for (int aid : cancelled) drop(Table::Appointments, aid);
+        reindexDoctors();
+        reindexAppointments();
         return true;
     }
     return false;
 }
 
 std::optional<Doctor> Hospital::findDoctorById(int id) const {
-    for (const auto &d : doctors)
-        if (d.getId() == id) return d;
+    if (const Doctor *d = findDoctorPtr(id)) return *d;
     return std::nullopt;
 }
 
+const Doctor *Hospital::findDoctorPtr(int id) const {
+    auto it = doctorIndex.find(id);
+    return it != doctorIndex.end() ? &doctors[it->second] : nullptr;
+}
+
+const std::vector<Doctor> &Hospital::getAllDoctors() const {
+    return doctors;
+}
+
 std::vector<Doctor> Hospital::searchDoctorsByName(const std::string &q) const {
-    std::vector<Doctor> out;
     std::string lowq = q;
     std::transform(lowq.begin(), lowq.end(), lowq.begin(), ::tolower);
+    const std::uint64_t gen = getGeneration(Table::Doctors);
+    if (auto cached = doctorSearches.get(lowq, gen)) return *cached;
+
+    std::vector<Doctor> out;
     for (const auto &d : doctors) {
         std::string n = d.getName();
         std::transform(n.begin(), n.end(), n.begin(), ::tolower);
         if (n.find(lowq) != std::string::npos) out.push_back(d);
     }
-    return out;
+    const std::size_t rows = out.size() + 1;
+    return *doctorSearches.put(lowq, gen, std::move(out), rows);
 }
 
 // --------------------------------------------------
 //  APPOINTMENTS
 // --------------------------------------------------
 
-Appointment Hospital::bookAppointment(int patientId, int doctorId, const std::string &date, const std::string &time) {
-    if (!findPatientById(patientId)) throw std::runtime_error("Patient not found");
-    auto doc = findDoctorById(doctorId);
-    if (!doc)   throw std::runtime_error("Doctor not found");
+Appointment Hospital::bookAppointment(int patientId, int doctorId, std::string date, std::string time) {
+    emplaceAppointment(patientId, doctorId, std::move(date), std::move(time));
+    return appointments.back();
+}
 
-    // Check for clash: same doctor, same date, same time
-    for (const auto &a : appointments) {
-        if (a.getDoctorId() == doctorId && a.getDate() == date && a.getTime() == time) {
-            throw std::runtime_error("Doctor not available at the chosen date/time (clash detected).");
-        }
-    }
+int Hospital::emplaceAppointment(int patientId, int doctorId, std::string date, std::string time) {
+    if (!findPatientPtr(patientId)) throw std::runtime_error("Patient not found");
+    if (!findDoctorPtr(doctorId))   throw std::runtime_error("Doctor not found");
 
-    Appointment a(nextAppointmentId++, patientId, doctorId, date, time);
-    appointments.push_back(a);
-    return a;
+    // Check for clash: same doctor, same date, same time
+    auto slot = bookedSlots.insert(SlotKey{doctorId, date, time});
+    if (!slot.second)
+        throw std::runtime_error("Doctor not available at the chosen date/time (clash detected).");
+
+    int id = nextAppointmentId++;
+    appointments.emplace_back(id, patientId, doctorId, std::move(date), std::move(time));
+    appointmentIndex[id] = appointments.size() - 1;
+    touch(Table::Appointments, id, Mutation::Book);
+    return id;
 }
 
 const std::vector<Appointment> &Hospital::getAllAppointments() const {
     return appointments;
 }
 
+const Appointment *Hospital::findAppointmentPtr(int id) const {
+    auto it = appointmentIndex.find(id);
+    return it != appointmentIndex.end() ? &appointments[it->second] : nullptr;
+}
+
+bool Hospital::isSlotBooked(int doctorId, const std::string &date, const std::string &time) const {
+    return bookedSlots.count(SlotKey{doctorId, date, time}) != 0;
+}
+
 // --------------------------------------------------
 //  BILLING
 // --------------------------------------------------
 
 Billing Hospital::generateBill(int appointmentId) {
+    emplaceBill(appointmentId);
+    return bills.back();
+}
+
+int Hospital::emplaceBill(int appointmentId) {
     // find appointment
-    const Appointment *ap = nullptr;
-    for (const auto &a : appointments) {
-        if (a.getId() == appointmentId) {
-            ap = &a;
-            break;
-        }
-    }
+    const Appointment *ap = findAppointmentPtr(appointmentId);
     if (!ap) throw std::runtime_error("Appointment not found");
 
     // find doctor
-    auto docopt = findDoctorById(ap->getDoctorId());
-    if (!docopt) throw std::runtime_error("Doctor not found");
+    const Doctor *doc = findDoctorPtr(ap->getDoctorId());
+    if (!doc) throw std::runtime_error("Doctor not found");
 
-    double base = getConsultationFeeBase(docopt->getSpecialty());
+    double base = getConsultationFeeBase(doc->getSpecialty());
     double gst = 0.18 * base;
     double total = base + gst;
 
     // round to nearest rupee (integer)
     double totalRounded = std::round(total);
 
-    Billing b(
-        nextBillId++,
+    int id = nextBillId++;
+    bills.emplace_back(
+        id,
         ap->getId(),
-        docopt->getId(),
+        doc->getId(),
         totalRounded,
         "Consultation Fee (incl. GST 18%)",
         ap->getDate()
     );
-
-    bills.push_back(b);
-    return b;
+    touch(Table::Billing, id, Mutation::Bill);
+    return id;
 }
 
 const std::vector<Billing> &Hospital::getAllBills() const {
     return bills;
 }
 
+double Hospital::getTotalBilled() const {
+    const std::uint64_t gen = getGeneration(Table::Billing);
+    if (auto cached = billingTotals.get("*", gen)) return *cached;
+
+    double total = 0.0;
+    for (const auto &b : bills) total += b.getAmount();
+    return *billingTotals.put("*", gen, total, 1);
+}
+
+double Hospital::getTotalBilledForDoctor(int doctorId) const {
+    const std::string key = std::to_string(doctorId);
+    const std::uint64_t gen = getGeneration(Table::Billing);
+    if (auto cached = billingTotals.get(key, gen)) return *cached;
+
+    double total = 0.0;
+    for (const auto &b : bills)
+        if (b.getDoctorId() == doctorId) total += b.getAmount();
+    return *billingTotals.put(key, gen, total, 1);
+}
+
 // --------------------------------------------------
 // LOAD (CSV)
 // --------------------------------------------------
 
+// Rows are parsed into a local vector (malformed rows are skipped) and only
+// swapped in once parsing is done, so the table and its indexes are never
+// left half-loaded. The reset (change maps, generation, Reload event) is only
+// recorded once the new rows are in place.
+
 void Hospital::loadPatients(const std::string &file) {
     auto rows = CSV::readCSV(file);
-    patients.clear();
-    nextPatientId = 1;
+    std::vector<Patient> loaded;
+    loaded.reserve(rows.size());
+    int nextId = 1;
     for (auto &r : rows) {
         if (r.size() < 5) continue;
-        int id = 0;
-        try { id = std::stoi(r[0]); } catch(...) { continue; }
-        patients.emplace_back(id, r[1], std::stoi(r[2]), r[3], r[4]);
-        if (id >= nextPatientId) nextPatientId = id + 1;
+        int id = 0, age = 0;
+        try { id = std::stoi(r[0]); age = std::stoi(r[2]); } catch(...) { continue; }
+        loaded.emplace_back(id, std::move(r[1]), age, std::move(r[3]), std::move(r[4]));
+        if (id >= nextId) nextId = id + 1;
     }
+    patients.swap(loaded);
+    nextPatientId = nextId;
+    reindexPatients();
+    resetTable(Table::Patients);
     std::cout << "Loaded " << patients.size() << " patients.\n";
 }
 
 void Hospital::loadDoctors(const std::string &file) {
     auto rows = CSV::readCSV(file);
-    doctors.clear();
-    nextDoctorId = 1;
+    std::vector<Doctor> loaded;
+    loaded.reserve(rows.size());
+    int nextId = 1;
     for (auto &r : rows) {
         if (r.size() < 4) continue;
         int id = 0;
         try { id = std::stoi(r[0]); } catch(...) { continue; }
-        doctors.emplace_back(id, r[1], r[2], r[3]);
-        if (id >= nextDoctorId) nextDoctorId = id + 1;
+        loaded.emplace_back(id, std::move(r[1]), std::move(r[2]), std::move(r[3]));
+        if (id >= nextId) nextId = id + 1;
     }
+    doctors.swap(loaded);
+    nextDoctorId = nextId;
+    reindexDoctors();
+    resetTable(Table::Doctors);
     std::cout << "Loaded " << doctors.size() << " doctors.\n";
 }
 
 void Hospital::loadAppointments(const std::string &file) {
     auto rows = CSV::readCSV(file);
-    appointments.clear();
-    nextAppointmentId = 1;
+    std::vector<Appointment> loaded;
+    loaded.reserve(rows.size());
+    int nextId = 1;
     for (auto &r : rows) {
         if (r.size() < 5) continue;
-        int id = 0;
-        try { id = std::stoi(r[0]); } catch(...) { continue; }
-        appointments.emplace_back(id, std::stoi(r[1]), std::stoi(r[2]), r[3], r[4]);
-        if (id >= nextAppointmentId) nextAppointmentId = id + 1;
+        int id = 0, pid = 0, did = 0;
+        try { id = std::stoi(r[0]); pid = std::stoi(r[1]); did = std::stoi(r[2]); } catch(...) { continue; }
+        loaded.emplace_back(id, pid, did, std::move(r[3]), std::move(r[4]));
+        if (id >= nextId) nextId = id + 1;
     }
+    appointments.swap(loaded);
+    nextAppointmentId = nextId;
+    reindexAppointments();
+    resetTable(Table::Appointments);
     std::cout << "Loaded " << appointments.size() << " appointments.\n";
 }
 
 void Hospital::loadBilling(const std::string &file) {
     auto rows = CSV::readCSV(file);
-    bills.clear();
-    nextBillId = 1;
+    std::vector<Billing> loaded;
+    loaded.reserve(rows.size());
+    int nextId = 1;
     for (auto &r : rows) {
         if (r.size() < 6) continue;
-        int id = 0;
-        try { id = std::stoi(r[0]); } catch(...) { continue; }
+        int id = 0, aid = 0, did = 0;
+        try { id = std::stoi(r[0]); aid = std::stoi(r[1]); did = std::stoi(r[2]); } catch(...) { continue; }
         double amount = 0.0;
         try { amount = std::stod(r[3]); } catch(...) { amount = 0.0; }
-        bills.emplace_back(id, std::stoi(r[1]), std::stoi(r[2]), amount, r[4], r[5]);
-        if (id >= nextBillId) nextBillId = id + 1;
+        loaded.emplace_back(id, aid, did, amount, std::move(r[4]), std::move(r[5]));
+        if (id >= nextId) nextId = id + 1;
     }
+    bills.swap(loaded);
+    nextBillId = nextId;
+    resetTable(Table::Billing);
     std::cout << "Loaded " << bills.size() << " bills.\n";
 }
 
@@ -274,33 +474,42 @@ void Hospital::loadBilling(const std::string &file) {
 // --------------------------------------------------
 
 void Hospital::savePatients(const std::string &file) {
-    std::vector<std::string> header = {"id","name","age","gender","contact"};
-    std::vector<std::vector<std::string>> rows;
-    for (const auto &p : patients)
-        rows.push_back({std::to_string(p.getId()), p.getName(), std::to_string(p.getAge()), p.getGender(), p.getContact()});
-    CSV::writeCSV(file, header, rows);
+    CSV::Writer w(file);
+    w.row({"id","name","age","gender","contact"});
+    for (const auto &p : patients) {
+        w.field(p.getId()).field(p.getName()).field(p.getAge()).field(p.getGender()).field(p.getContact());
+        w.endRow();
+    }
+    w.commit();
 }
 
 void Hospital::saveDoctors(const std::string &file) {
-    std::vector<std::string> header = {"id","name","specialty","contact"};
-    std::vector<std::vector<std::string>> rows;
-    for (const auto &d : doctors)
-        rows.push_back({std::to_string(d.getId()), d.getName(), d.getSpecialty(), d.getContact()});
-    CSV::writeCSV(file, header, rows);
+    CSV::Writer w(file);
+    w.row({"id","name","specialty","contact"});
+    for (const auto &d : doctors) {
+        w.field(d.getId()).field(d.getName()).field(d.getSpecialty()).field(d.getContact());
+        w.endRow();
+    }
+    w.commit();
 }
 
 void Hospital::saveAppointments(const std::string &file) {
-    std::vector<std::string> header = {"id","patientId","doctorId","date","time"};
-    std::vector<std::vector<std::string>> rows;
-    for (const auto &a : appointments)
-        rows.push_back({std::to_string(a.getId()), std::to_string(a.getPatientId()), std::to_string(a.getDoctorId()), a.getDate(), a.getTime()});
-    CSV::writeCSV(file, header, rows);
+    CSV::Writer w(file);
+    w.row({"id","patientId","doctorId","date","time"});
+    for (const auto &a : appointments) {
+        w.field(a.getId()).field(a.getPatientId()).field(a.getDoctorId()).field(a.getDate()).field(a.getTime());
+        w.endRow();
+    }
+    w.commit();
 }
 
 void Hospital::saveBilling(const std::string &file) {
-    std::vector<std::string> header = {"billId","appointmentId","doctorId","amount","description","date"};
-    std::vector<std::vector<std::string>> rows;
-    for (const auto &b : bills)
-        rows.push_back({std::to_string(b.getBillId()), std::to_string(b.getAppointmentId()), std::to_string(b.getDoctorId()), std::to_string(static_cast<long long>(b.getAmount())), b.getDescription(), b.getDate()});
-    CSV::writeCSV(file, header, rows);
+    CSV::Writer w(file);
+    w.row({"billId","appointmentId","doctorId","amount","description","date"});
+    for (const auto &b : bills) {
+        w.field(b.getBillId()).field(b.getAppointmentId()).field(b.getDoctorId())
+         .field(static_cast<long long>(b.getAmount())).field(b.getDescription()).field(b.getDate());
+        w.endRow();
+    }
+    w.commit();
 }
@@ -0,0 +1,192 @@
+#include "Scheduler.h"
+#include "DateTime.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+    // Lowest set bit index; `bits` must be non-zero
+    int lowestBit(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int i = 0;
+        while (!(bits & 1)) { bits >>= 1; ++i; }
+        return i;
+#endif
+    }
+
+    // Booked slots of one doctor: day -> bitmask of taken slots
+    using DayMasks = std::unordered_map<int, std::uint64_t>;
+
+    // Min-heap entry: (load, doctorId). Entries whose load no longer matches the
+    // doctor's current load are stale and skipped when popped.
+    using LoadEntry = std::pair<int, int>;
+    using LoadHeap = std::priority_queue<LoadEntry, std::vector<LoadEntry>, std::greater<LoadEntry>>;
+}
+
+Scheduler::Scheduler(Hospital &hosp, const std::string &dayStart, const std::string &dayEnd, int slotMinutes)
+    : hosp(hosp), dayStart(0), slotMinutes(slotMinutes), slotsPerDay(0) {
+    int end = 0;
+    if (!DateTime::parseTime(dayStart, this->dayStart) || !DateTime::parseTime(dayEnd, end))
+        throw std::invalid_argument("Scheduler: day start/end must be HH:MM");
+    if (slotMinutes <= 0 || end <= this->dayStart)
+        throw std::invalid_argument("Scheduler: empty working day");
+    slotsPerDay = (end - this->dayStart) / slotMinutes;
+    if (slotsPerDay < 1 || slotsPerDay > 64)
+        throw std::invalid_argument("Scheduler: between 1 and 64 slots per day are supported");
+}
+
+std::uint64_t Scheduler::overlapMask(int minute) const {
+    // floor division, so times before dayStart map to negative slots
+    auto slotOf = [&](int m) {
+        int off = m - dayStart;
+        return off >= 0 ? off / slotMinutes : -((-off + slotMinutes - 1) / slotMinutes);
+    };
+    int firstSlot = std::max(slotOf(minute), 0);
+    int lastSlot = std::min(slotOf(minute + slotMinutes - 1), slotsPerDay - 1);
+    std::uint64_t mask = 0;
+    for (int s = firstSlot; s <= lastSlot; ++s) mask |= 1ULL << s;
+    return mask;
+}
+
+std::vector<ScheduleResult> Scheduler::schedule(const std::vector<ScheduleRequest> &batch) {
+    std::vector<ScheduleResult> results(batch.size());
+    const std::uint64_t allSlots = slotsPerDay == 64 ? ~0ULL : ((1ULL << slotsPerDay) - 1);
+
+    // validate requests and find the overall date window
+    std::vector<std::pair<int, int>> window(batch.size());
+    int minDay = 0, maxDay = -1;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto &r = batch[i];
+        results[i].request = i;
+        int e = 0, l = 0;
+        if (!hosp.findPatientPtr(r.patientId)) { results[i].reason = "Patient not found"; continue; }
+        if (!DateTime::parseDate(r.earliestDate, e) || !DateTime::parseDate(r.latestDate, l) || e > l) {
+            results[i].reason = "Invalid date window";
+            continue;
+        }
+        window[i] = {e, l};
+        if (maxDay < minDay) { minDay = e; maxDay = l; }
+        else { minDay = std::min(minDay, e); maxDay = std::max(maxDay, l); }
+    }
+
+    // doctors per specialty, and each doctor's booked slots and load in the window
+    std::unordered_map<std::string, std::vector<int>> bySpecialty;
+    for (const auto &r : batch) bySpecialty.emplace(r.specialty, std::vector<int>());
+    std::unordered_map<int, DayMasks> booked;      // per doctor
+    std::unordered_map<int, DayMasks> patientBusy; // per patient in the batch
+    std::unordered_map<int, int> load;
+    for (const auto &d : hosp.getAllDoctors()) {
+        auto it = bySpecialty.find(d.getSpecialty());
+        if (it == bySpecialty.end()) continue;
+        it->second.push_back(d.getId());
+        booked[d.getId()];
+        load[d.getId()] = 0;
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        if (results[i].reason.empty()) patientBusy[batch[i].patientId];
+    for (const auto &a : hosp.getAllAppointments()) {
+        auto bk = booked.find(a.getDoctorId());
+        auto pb = patientBusy.find(a.getPatientId());
+        if (bk == booked.end() && pb == patientBusy.end()) continue;
+        int day = 0, minute = 0;
+        if (!DateTime::parseDate(a.getDate(), day) || day < minDay || day > maxDay) continue;
+        if (bk != booked.end()) ++load[a.getDoctorId()];
+        if (!DateTime::parseTime(a.getTime(), minute)) continue;
+        std::uint64_t mask = overlapMask(minute);
+        if (!mask) continue;
+        if (bk != booked.end()) bk->second[day] |= mask;
+        if (pb != patientBusy.end()) pb->second[day] |= mask;
+    }
+
+    std::unordered_map<std::string, LoadHeap> heaps;
+    for (const auto &[spec, ids] : bySpecialty) {
+        auto &heap = heaps[spec];
+        for (int id : ids) heap.emplace(load[id], id);
+    }
+
+    // earliest deadline first, then earliest start, then batch order
+    using Pending = std::tuple<int, int, std::size_t>;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> pending;
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        if (results[i].reason.empty()) pending.emplace(window[i].second, window[i].first, i);
+
+    // first (day, slot) within [first, last] that is free for both doctor and patient
+    auto findSlot = [&](int doctorId, const DayMasks &patient, int first, int last, int &day, int &slot) {
+        auto &days = booked[doctorId];
+        for (int d = first; d <= last; ++d) {
+            auto it = days.find(d);
+            auto pt = patient.find(d);
+            std::uint64_t freeSlots = allSlots & ~(it == days.end() ? 0 : it->second)
+                                              & ~(pt == patient.end() ? 0 : pt->second);
+            if (freeSlots) {
+                day = d;
+                slot = lowestBit(freeSlots);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    while (!pending.empty()) {
+        auto [last, first, i] = pending.top();
+        pending.pop();
+        const auto &req = batch[i];
+        auto &res = results[i];
+        auto &heap = heaps[req.specialty];
+        auto &patient = patientBusy[req.patientId];
+
+        int doctorId = 0, day = 0, slot = 0;
+        bool fromHeap = false;
+        if (req.preferredDoctorId && load.count(*req.preferredDoctorId) &&
+            hosp.findDoctorPtr(*req.preferredDoctorId)->getSpecialty() == req.specialty &&
+            findSlot(*req.preferredDoctorId, patient, first, last, day, slot)) {
+            doctorId = *req.preferredDoctorId;
+        } else {
+            // least loaded doctor with a free slot; full doctors go back afterwards
+            std::vector<LoadEntry> skipped;
+            while (!heap.empty()) {
+                auto [l, id] = heap.top();
+                heap.pop();
+                if (l != load[id]) continue; // stale
+                if (findSlot(id, patient, first, last, day, slot)) { doctorId = id; fromHeap = true; break; }
+                skipped.emplace_back(l, id);
+            }
+            for (const auto &e : skipped) heap.push(e);
+        }
+
+        if (!doctorId) {
+            res.reason = bySpecialty[req.specialty].empty() ? "No doctor with this specialty"
+                                                            : "No free slot in the requested window";
+            continue;
+        }
+
+        std::string date = DateTime::formatDate(day);
+        std::string time = DateTime::formatTime(dayStart + slot * slotMinutes);
+        try {
+            res.appointmentId = hosp.emplaceAppointment(req.patientId, doctorId, date, time);
+        } catch (const std::exception &ex) {
+            res.reason = ex.what();
+            if (fromHeap) heap.emplace(load[doctorId], doctorId); // unchanged load
+            continue;
+        }
+
+        // commit the slot and the load only once the booking succeeded
+        booked[doctorId][day] |= 1ULL << slot;
+        patient[day] |= 1ULL << slot;
+        heap.emplace(++load[doctorId], doctorId);
+
+        res.assigned = true;
+        res.doctorId = doctorId;
+        res.date = std::move(date);
+        res.time = std::move(time);
+    }
+    return results;
+}
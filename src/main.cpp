@@ -2,6 +2,7 @@
 #include <string>
 #include <limits>
 #include "Hospital.h"
+#include "Export.h"
 
 static void pause() {
     std::cout << "Press Enter to continue...";
@@ -157,6 +158,7 @@ int main() {
             else if (choice == 14) {
                 std::cout << "\nBills:\n";
                 for (const auto &b : hosp.getAllBills()) std::cout << b << "\n";
+                std::cout << "Total billed: ₹" << static_cast<long long>(hosp.getTotalBilled()) << "\n";
                 pause();
             }
             else if (choice == 15) {
@@ -164,6 +166,11 @@ int main() {
                 hosp.saveDoctors("data/doctors.csv");
                 hosp.saveAppointments("data/appointments.csv");
                 hosp.saveBilling("data/billing.csv");
+                try {
+                    Export::writeFile(hosp, "data/export.json", Export::Format::Json);
+                } catch (const std::exception &ex) {
+                    std::cerr << "Warning: could not write data/export.json: " << ex.what() << std::endl;
+                }
                 std::cout << "Saved. Exiting.\n";
                 break;
             }
@@ -0,0 +1,55 @@
+// Counts heap allocations per insert for the Hospital mutation API: copying
+// add* calls vs emplace* with moved arguments. See tests/README.md to build.
+#include "Hospital.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+static long allocations = 0;
+
+void *operator new(std::size_t n) {
+    ++allocations;
+    if (void *p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+static const int N = 100000;
+
+// strings longer than the small-string buffer, so every copy allocates
+static std::string longName(int i) { return "Patient name number " + std::to_string(i); }
+
+int main() {
+    const std::string name = longName(0), gender = "Not stated by patient", contact = "+91 98765 43210 ext 12";
+    int failures = 0;
+
+    // 1. copying API: add* with lvalue arguments
+    Hospital a;
+    long before = allocations;
+    for (int i = 0; i < N; ++i) a.addPatient(name, 30, gender, contact);
+    double perCopy = double(allocations - before) / N;
+
+    // 2. moving API: emplace* with arguments moved in (strings built beforehand)
+    std::vector<std::string> names, genders, contacts;
+    for (int i = 0; i < N; ++i) { names.push_back(longName(i)); genders.push_back(gender); contacts.push_back(contact); }
+    Hospital b;
+    before = allocations;
+    for (int i = 0; i < N; ++i) b.emplacePatient(std::move(names[i]), 30, std::move(genders[i]), std::move(contacts[i]));
+    double perMove = double(allocations - before) / N;
+
+    std::printf("addPatient (lvalues):         %.2f allocations/insert\n", perCopy);
+    std::printf("emplacePatient (moved):       %.2f allocations/insert\n", perMove);
+
+    // Moving saves the 3 argument copies and the 3 copies of the returned Patient.
+    // What remains is bookkeeping: one change-tracking node and one ID-index node
+    // per insert, plus amortised vector/hash table growth.
+    if (perMove > 2.5) { std::printf("FAIL: emplacePatient allocates more than its bookkeeping\n"); ++failures; }
+    if (perCopy - perMove < 5.5) { std::printf("FAIL: moving should save 6 string allocations per insert\n"); ++failures; }
+
+    std::printf(failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}
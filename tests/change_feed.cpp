@@ -0,0 +1,112 @@
+// Stresses the change feed with one producer lapping three consumers of
+// different speeds: every consumer must see intact events in order, and
+// delivered + dropped must equal published. Then checks that cursors follow
+// a feed through moves (including vector growth) but not through copies.
+// See tests/README.md to build; run it under -fsanitize=thread too.
+#include "Hospital.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+// Every field of event n is derived from n, so a torn read shows up as a mismatch
+static int idOf(std::uint64_t n) { return static_cast<int>(n * 2654435761u % 1000003); }
+static Table tableOf(std::uint64_t n) { return static_cast<Table>(n % 4); }
+static Mutation kindOf(std::uint64_t n) { return static_cast<Mutation>(n % 6); }
+
+static void stress() {
+    constexpr std::uint64_t kEvents = 2000000;
+    ChangeFeed feed(64);
+    std::vector<ChangeFeed::Cursor> cursors;
+    for (int i = 0; i < 3; ++i) cursors.push_back(feed.subscribe());
+
+    std::atomic<int> ready{0};
+    std::atomic<bool> done{false};
+    std::atomic<int> corrupt{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 3; ++c) {
+        consumers.emplace_back([&, c] {
+            ChangeFeed::Cursor &cur = cursors[c];
+            std::uint64_t last = 0;
+            bool first = true;
+            auto onEvent = [&](const MutationEvent &ev) {
+                const std::uint64_t n = ev.sequence;
+                if ((!first && n <= last) || ev.version != n + 1 || ev.id != idOf(n)
+                    || ev.table != tableOf(n) || ev.kind != kindOf(n))
+                    corrupt.fetch_add(1, std::memory_order_relaxed);
+                last = n;
+                first = false;
+            };
+            ready.fetch_add(1);
+            for (unsigned spin = 0; !done.load(std::memory_order_acquire); ++spin) {
+                if (auto ev = cur.poll()) onEvent(*ev);
+                if (c > 0 && spin % (c * 64) == 0) std::this_thread::yield(); // slower consumers get lapped
+            }
+            cur.drain(onEvent);
+        });
+    }
+
+    while (ready.load() < 3) std::this_thread::yield();
+    for (std::uint64_t n = 0; n < kEvents; ++n) {
+        feed.publish(tableOf(n), kindOf(n), idOf(n), n + 1);
+        if (n % 1024 == 0) std::this_thread::yield(); // give the fastest consumer a chance to keep up
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : consumers) t.join();
+
+    check(corrupt.load() == 0, "consumers saw only intact, ordered events");
+    for (int c = 0; c < 3; ++c) {
+        auto s = cursors[c].stats();
+        std::printf("consumer %d: delivered %llu, dropped %llu, max lag %llu\n", c,
+                    static_cast<unsigned long long>(s.delivered), static_cast<unsigned long long>(s.dropped),
+                    static_cast<unsigned long long>(s.maxLag));
+        check(s.delivered + s.dropped == feed.published(), "delivered + dropped == published");
+        check(s.lag == 0, "consumer caught up");
+    }
+}
+
+static void moves() {
+    Hospital h;
+    auto cur = h.subscribe();
+
+    Hospital moved = std::move(h);
+    moved.addPatient("Moved", 30, "F", "9000000001");
+    check(cur.drain([](const MutationEvent &) {}) == 1, "cursor follows a moved Hospital");
+
+    h.addPatient("Left Behind", 30, "M", "9000000002"); // moved-from: still usable, publishes nowhere
+    check(!h.subscribe().poll(), "moved-from feed is detached");
+    check(!cur.poll(), "moved-from Hospital does not publish to the moved-to feed");
+
+    Hospital copy = moved;
+    copy.addPatient("Copy", 30, "F", "9000000003");
+    check(!cur.poll(), "cursor does not follow a copy");
+
+    Hospital assigned;
+    assigned = std::move(moved);
+    assigned.addPatient("Assigned", 30, "M", "9000000004");
+    check(cur.drain([](const MutationEvent &) {}) == 1, "cursor follows move assignment");
+
+    std::vector<Hospital> v;
+    v.emplace_back();
+    auto first = v[0].subscribe();
+    for (int i = 0; i < 32; ++i) v.emplace_back(); // reallocates, moving v[0]
+    v[0].addPatient("Grown", 30, "F", "9000000005");
+    check(first.drain([](const MutationEvent &) {}) == 1, "cursor survives vector growth");
+}
+
+int main() {
+    stress();
+    moves();
+    std::printf(failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}
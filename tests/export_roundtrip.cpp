@@ -0,0 +1,168 @@
+// Decodes Columnar exports with Export::read and replays them onto a replica:
+// a full export, then a delta with an unparseable date (dict fallback), an edit,
+// and a patient delete whose appointments are cascaded. Also checks the JSON
+// delta, table reloads, and full resets on a stale or foreign position.
+// See tests/README.md to build.
+#include "Export.h"
+#include <array>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+using Rows = std::map<int, std::vector<std::string>>;   // first column -> row
+using Replica = std::array<Rows, 4>;                     // indexed by Table
+
+// What an up-to-date consumer should hold, rendered as CSV text
+static Replica expected(const Hospital &h) {
+    Replica r;
+    for (const auto &p : h.getAllPatients())
+        r[0][p.getId()] = {std::to_string(p.getId()), p.getName(), std::to_string(p.getAge()), p.getGender(), p.getContact()};
+    for (const auto &d : h.getAllDoctors())
+        r[1][d.getId()] = {std::to_string(d.getId()), d.getName(), d.getSpecialty(), d.getContact()};
+    for (const auto &a : h.getAllAppointments())
+        r[2][a.getId()] = {std::to_string(a.getId()), std::to_string(a.getPatientId()),
+                           std::to_string(a.getDoctorId()), a.getDate(), a.getTime()};
+    for (const auto &b : h.getAllBills())
+        r[3][b.getBillId()] = {std::to_string(b.getBillId()), std::to_string(b.getAppointmentId()),
+                               std::to_string(b.getDoctorId()), std::to_string(static_cast<long long>(b.getAmount())),
+                               b.getDescription(), b.getDate()};
+    return r;
+}
+
+static Export::Delta roundTrip(const Hospital &h, Export::Position since, Export::Position &next) {
+    std::stringstream buf;
+    next = Export::write(h, buf, Export::Format::Columnar, since);
+    return Export::read(buf);
+}
+
+static void replay(Replica &r, const Export::Delta &d) {
+    for (std::size_t t = 0; t < r.size(); ++t) {
+        const auto &td = d.tables[t];
+        if (td.reset) r[t].clear();
+        for (const auto &row : td.rows) r[t][std::stoi(row[0])] = row;
+        for (int id : td.deleted) r[t].erase(id);
+    }
+}
+
+static std::size_t changedRows(const Export::Delta &d) {
+    std::size_t n = 0;
+    for (const auto &t : d.tables) n += t.rows.size();
+    return n;
+}
+
+int main() {
+    Hospital h;
+    for (int i = 0; i < 5000; ++i)   // more than one block
+        h.emplacePatient("Patient " + std::to_string(i), 20 + i % 60, i % 2 ? "F" : "M", "9" + std::to_string(100000000 + i));
+    int cardio = h.emplaceDoctor("Dr. Bob Smith", "Cardiology", "9876501234");
+    int derm = h.emplaceDoctor("Dr. Jane, \"JD\" Doe", "Dermatology", "9876501235");
+    int a1 = h.emplaceAppointment(1, cardio, "2025-01-10", "10:00");
+    int a2 = h.emplaceAppointment(2, derm, "2025-01-11", "11:30");
+    h.emplaceAppointment(2, cardio, "2024-12-31", "09:15");
+    h.emplaceBill(a1);
+    h.emplaceBill(a2);
+
+    // full export
+    Export::Position pos;
+    Export::Delta full = roundTrip(h, {}, pos);
+    check(pos.epoch == h.getEpoch() && pos.version == h.getVersion(), "returned position");
+    check(full.position.epoch == pos.epoch && full.position.version == pos.version, "decoded position");
+    check(full.since == 0, "full export starts from 0");
+    bool allReset = true;
+    for (const auto &t : full.tables) allReset = allReset && t.reset;
+    check(allReset, "full export resets every table");
+    check(full.tables[0].columns == std::vector<std::string>{"id", "name", "age", "gender", "contact"}, "patient columns");
+    Replica replica;
+    replay(replica, full);
+    check(replica == expected(h), "full export round-trips");
+
+    // delta: one unparseable date, one edit, one delete cascading to two appointments
+    int odd = h.emplaceAppointment(3, derm, "next Tuesday", "9am");
+    h.editPatient(4, "Patient Four", 44, "F", "9000000004");
+    h.deletePatient(2);
+    Export::Position since = pos;
+    Export::Delta delta = roundTrip(h, since, pos);
+    check(delta.since == since.version, "delta starts from the previous version");
+    bool anyReset = false;
+    for (const auto &t : delta.tables) anyReset = anyReset || t.reset;
+    check(!anyReset, "delta resets nothing");
+    check(changedRows(delta) == 2, "delta carries only the booked and edited rows");
+    check(delta.tables[2].rows.size() == 1 && delta.tables[2].rows[0][3] == "next Tuesday"
+          && delta.tables[2].rows[0][4] == "9am", "bad date and time survive via dict fallback");
+    check(delta.tables[0].deleted == std::vector<int>{2}, "patient tombstone");
+    check(delta.tables[2].deleted == std::vector<int>{a2, a2 + 1}, "cascaded appointment tombstones");
+    replay(replica, delta);
+    check(replica[2].count(odd) == 1, "replica has the new appointment");
+    check(replica == expected(h), "delta round-trips");
+
+    // the same delta as JSON, as the frontend reads it
+    std::ostringstream json;
+    Export::write(h, json, Export::Format::Json, since);
+    const std::string js = json.str();
+    auto has = [&](const std::string &s) { return js.find(s) != std::string::npos; };
+    check(has("\"epoch\":\"" + std::to_string(h.getEpoch()) + "\""), "json epoch");
+    check(has("\"since\":" + std::to_string(since.version)), "json since");
+    check(!has("\"reset\":true"), "json delta resets nothing");
+    check(has("\"date\":{\"enc\":\"dict\",\"dict\":[\"next Tuesday\"]"), "json dict fallback");
+    check(has("\"deleted\":[2]"), "json patient tombstone");
+    check(has("\"deleted\":[" + std::to_string(a2) + "," + std::to_string(a2 + 1) + "]"), "json cascaded tombstones");
+    check(has("\"Patient Four\""), "json edited row");
+
+    // nothing changed: empty delta
+    since = pos;
+    check(changedRows(roundTrip(h, since, pos)) == 0 && pos.version == since.version, "no-op delta is empty");
+
+    // reloading one table resets only that table
+    h.saveDoctors("export_roundtrip_doctors.csv");
+    h.loadDoctors("export_roundtrip_doctors.csv");
+    std::remove("export_roundtrip_doctors.csv");
+    Export::Delta reload = roundTrip(h, since, pos);
+    check(reload.tables[1].reset && !reload.tables[0].reset && !reload.tables[2].reset, "reload resets only doctors");
+    check(reload.tables[1].rows.size() == 2, "reloaded table sent in full");
+    replay(replica, reload);
+    check(replica == expected(h), "reload round-trips");
+
+    // positions from another epoch, at 0, or ahead of the Hospital start over
+    const Export::Position stale[] = {{pos.epoch + 1, pos.version}, {pos.epoch, pos.version + 1}, {pos.epoch, 0}};
+    for (const auto &p : stale) {
+        Export::Position next;
+        Export::Delta d = roundTrip(h, p, next);
+        bool reset = d.since == 0;
+        for (const auto &t : d.tables) reset = reset && t.reset;
+        check(reset, "stale position gets a full reset");
+        Replica fresh;
+        replay(fresh, d);
+        check(fresh == expected(h), "full reset round-trips");
+    }
+    Hospital copy = h;
+    Export::Position next;
+    check(roundTrip(copy, pos, next).since == 0 && next.epoch != pos.epoch, "a copy has its own epoch");
+
+    // truncated input is rejected, not half-decoded
+    std::stringstream buf;
+    Export::write(h, buf, Export::Format::Columnar);
+    std::string bytes = buf.str();
+    bool threw = false;
+    try {
+        std::istringstream cut(bytes.substr(0, bytes.size() / 2));
+        Export::read(cut);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "truncated export throws");
+
+    std::printf("%zu bytes for a full export of %zu patients\n", bytes.size(), h.getAllPatients().size());
+    std::printf(failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,62 @@
+// Copies a Hospital whose result caches are warm and checks that the original
+// and the copy stay independent (caches and change feeds). See tests/README.md to build.
+#include "Hospital.h"
+#include <cstdio>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+int main() {
+    Hospital h;
+    h.addPatient("Alice Johnson", 30, "F", "9876543210");
+    h.addPatient("Alan Turing", 41, "M", "9123456789");
+    h.addDoctor("Dr. Bob Smith", "Cardiology", "9876501234");
+    h.bookAppointment(1, 1, "2025-01-10", "10:00");
+    h.generateBill(1);
+
+    // warm every cache
+    check(h.searchPatientsByName("al").size() == 2, "original search before copy");
+    check(h.searchDoctorsByName("bob").size() == 1, "original doctor search before copy");
+    double total = h.getTotalBilled();
+
+    Hospital c = h;
+    check(c.searchPatientsByName("al").size() == 2, "copy search");
+    check(c.getTotalBilled() == total, "copy billing total");
+
+    // mutate each side; the other must not see it and must not touch freed cache entries
+    c.addPatient("Alma Copy", 22, "F", "9000000000");
+    check(c.searchPatientsByName("al").size() == 3, "copy sees its own insert");
+    check(h.searchPatientsByName("al").size() == 2, "original unaffected by copy");
+    h.deletePatient(2);
+    check(h.searchPatientsByName("al").size() == 1, "original sees its own delete");
+    check(c.searchPatientsByName("al").size() == 3, "copy unaffected by original");
+
+    // each copy publishes to its own change feed
+    Hospital e = h;
+    auto original = h.subscribe();
+    auto copied = e.subscribe();
+    std::uint64_t before = h.getChangeFeed().published();
+    e.addPatient("Feed Copy", 33, "M", "9222222222");
+    check(h.getChangeFeed().published() == before, "copy does not publish into the original feed");
+    check(!original.poll(), "original subscriber does not see copy mutations");
+    check(copied.poll().has_value(), "copy subscriber sees copy mutations");
+    h.addPatient("Feed Source", 34, "F", "9333333333");
+    check(original.poll().has_value() && !copied.poll(), "original mutations stay in the original feed");
+
+    // copy-assignment over a warm cache
+    Hospital d;
+    d.addPatient("Alfred", 50, "M", "9111111111");
+    check(d.searchPatientsByName("al").size() == 1, "assign target warm");
+    d = h;
+    check(d.searchPatientsByName("al").size() == 1 && d.searchPatientsByName("al")[0].getName() == "Alice Johnson",
+          "assigned copy returns source data");
+
+    std::printf(failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}
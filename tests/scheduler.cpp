@@ -0,0 +1,129 @@
+// Checks the batch scheduler: an off-grid booking blocks both slots it
+// overlaps, a patient is never double-booked across doctors, a preferred
+// doctor of the wrong specialty falls back to the least loaded one, and load
+// spreads evenly. Ends with a timing line for a day-sized batch.
+// See tests/README.md to build.
+#include "Scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+static ScheduleRequest request(int patientId, const std::string &specialty, const std::string &from,
+                               const std::string &to, std::optional<int> preferred = std::nullopt) {
+    return ScheduleRequest{patientId, specialty, from, to, preferred};
+}
+
+// No patient holds two appointments at the same date and time
+static bool noPatientDoubleBooked(const Hospital &h) {
+    std::set<std::tuple<int, std::string, std::string>> seen;
+    for (const auto &a : h.getAllAppointments())
+        if (!seen.emplace(a.getPatientId(), a.getDate(), a.getTime()).second) return false;
+    return true;
+}
+
+static void offGrid() {
+    Hospital h;
+    int p1 = h.emplacePatient("Off Grid", 40, "F", "9000000001");
+    int p2 = h.emplacePatient("Next In Line", 41, "M", "9000000002");
+    int d = h.emplaceDoctor("Dr. Only", "Cardiology", "9000000100");
+    h.emplaceAppointment(p1, d, "2025-03-03", "09:07"); // overlaps the 09:00 and 09:15 slots
+
+    auto res = Scheduler(h).schedule({request(p2, "Cardiology", "2025-03-03", "2025-03-03")});
+    check(res[0].assigned && res[0].time == "09:30", "off-grid booking blocks two slots");
+}
+
+static void patientAcrossDoctors() {
+    Hospital h;
+    int p = h.emplacePatient("Busy Patient", 50, "M", "9000000001");
+    int d1 = h.emplaceDoctor("Dr. One", "Neurology", "9000000101");
+    h.emplaceDoctor("Dr. Two", "Neurology", "9000000102");
+    h.emplaceAppointment(p, d1, "2025-03-03", "09:00");
+
+    std::vector<ScheduleRequest> batch(3, request(p, "Neurology", "2025-03-03", "2025-03-03"));
+    auto res = Scheduler(h).schedule(batch);
+    bool all = std::all_of(res.begin(), res.end(), [](const ScheduleResult &r) { return r.assigned; });
+    bool avoids = std::none_of(res.begin(), res.end(), [](const ScheduleResult &r) { return r.time == "09:00"; });
+    check(all && avoids, "patient's existing appointment is avoided");
+    check(noPatientDoubleBooked(h), "patient never double-booked across doctors");
+}
+
+static void wrongSpecialtyPreference() {
+    Hospital h;
+    int p = h.emplacePatient("Prefers Derm", 30, "F", "9000000001");
+    int derm = h.emplaceDoctor("Dr. Skin", "Dermatology", "9000000101");
+    int c1 = h.emplaceDoctor("Dr. Heart", "Cardiology", "9000000102");
+    int c2 = h.emplaceDoctor("Dr. Valve", "Cardiology", "9000000103");
+    h.emplaceAppointment(h.emplacePatient("Earlier", 60, "M", "9000000002"), c1, "2025-03-03", "10:00");
+
+    auto res = Scheduler(h).schedule({request(p, "Cardiology", "2025-03-03", "2025-03-04", derm)});
+    check(res[0].assigned && res[0].doctorId == c2, "wrong-specialty preference falls back to the least loaded doctor");
+}
+
+static void loadBalance() {
+    Hospital h;
+    std::vector<int> doctors;
+    for (int i = 0; i < 3; ++i)
+        doctors.push_back(h.emplaceDoctor("Dr. " + std::to_string(i), "Orthopedics", "90000001" + std::to_string(i)));
+    std::vector<ScheduleRequest> batch;
+    for (int i = 0; i < 30; ++i)
+        batch.push_back(request(h.emplacePatient("P" + std::to_string(i), 30, "M", "9" + std::to_string(100000000 + i)),
+                                "Orthopedics", "2025-03-03", "2025-03-07"));
+
+    std::map<int, int> load;
+    for (const auto &r : Scheduler(h).schedule(batch))
+        if (r.assigned) ++load[r.doctorId];
+    check(load.size() == 3 && load[doctors[0]] == 10 && load[doctors[1]] == 10 && load[doctors[2]] == 10,
+          "requests spread evenly across doctors");
+}
+
+static void dayBatch() {
+    constexpr int kSpecialties = 10, kDoctors = 500, kRequests = 15000;
+    Hospital h;
+    for (int i = 0; i < kDoctors; ++i)
+        h.emplaceDoctor("Dr. " + std::to_string(i), "Specialty " + std::to_string(i % kSpecialties),
+                        "9" + std::to_string(200000000 + i));
+    std::vector<ScheduleRequest> batch;
+    batch.reserve(kRequests);
+    for (int i = 0; i < kRequests; ++i)
+        batch.push_back(request(h.emplacePatient("P" + std::to_string(i), 30, "F", "9" + std::to_string(100000000 + i)),
+                                "Specialty " + std::to_string(i % kSpecialties), "2025-03-03", "2025-03-03"));
+
+    auto start = std::chrono::steady_clock::now();
+    auto res = Scheduler(h).schedule(batch);
+    auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::map<int, int> load;
+    for (const auto &r : res)
+        if (r.assigned) ++load[r.doctorId];
+    auto [lo, hi] = std::minmax_element(load.begin(), load.end(),
+        [](const auto &a, const auto &b) { return a.second < b.second; });
+    check(static_cast<int>(h.getAllAppointments().size()) == kRequests, "whole batch assigned");
+    check(hi->second - lo->second <= 2, "day batch load within 2 across doctors");
+    check(noPatientDoubleBooked(h), "day batch double-books no patient");
+    std::printf("%d requests, %d doctors: %.1f ms (load %d..%d per doctor)\n",
+                kRequests, kDoctors, ms, lo->second, hi->second);
+}
+
+int main() {
+    offGrid();
+    patientAcrossDoctors();
+    wrongSpecialtyPreference();
+    loadBalance();
+    dayBatch();
+    std::printf(failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}